@@ -4,10 +4,20 @@
 #include <string>
 #include <stdexcept>
 #include <cstdint>
-#include <vector>
+#include <concepts>
+#include <ranges>
+#include <span>
+#include <type_traits>
+
+#include <GLA/fileMapping.h>
 
 namespace gla {
 
+class DeletionQueue;
+class Readback;
+class ReadbackQueue;
+struct BufferSlice;
+
 /**
  * @brief Enum to indicate the type of Buffer.
  */
@@ -110,7 +120,8 @@ enum class BufferFlag : uint32_t {
     MapWrite        = 1 << 2, ///< Indicates that the data store may be mapped by the client for write access and a pointer in the client's address space obtained that may be written through.
     MapPersistent   = 1 << 3, ///< Indicates that the client may request that the server read from or write to the buffer while it is mapped. The client's pointer to the data store remains valid so long as the data store is mapped, even during execution of drawing or dispatch commands.
     MapCoherent     = 1 << 4, ///< Indicates thar shared access to buffers that are simultaneously mapped for client access and are used by the server will be coherent, so long as that mapping is performed using glMapBufferRange.
-    ClientStorage   = 1 << 5  ///< When all other criteria for the buffer storage allocation are met, this bit may be used by an implementation to determine whether to use storage that is local to the server or to the client to serve as the backing store for the buffer.
+    ClientStorage   = 1 << 5, ///< When all other criteria for the buffer storage allocation are met, this bit may be used by an implementation to determine whether to use storage that is local to the server or to the client to serve as the backing store for the buffer.
+    Sparse          = 1 << 6  ///< Indicates that only virtual address space is reserved and physical pages are committed explicitly with Buffer::commitPages. Requires Capabilities::sparseBuffer (ARB_sparse_buffer).
 };
 
 inline BufferFlag operator|(BufferFlag a, BufferFlag b) {
@@ -130,6 +141,16 @@ inline BufferFlag& operator|=(BufferFlag& a, BufferFlag b) {
     return a;
 }
 
+/**
+ * @brief Enum to select how Buffer::setSubData avoids waiting for draws that still read the old contents.
+ */
+enum class UpdatePolicy {
+    SubData,        ///< Plain glBufferSubData, the driver may have to wait for the GPU.
+    Orphan,         ///< Updates of the whole Buffer re-specify it with glBufferData, so the driver can hand out fresh memory. Requires mutable storage.
+    Invalidate,     ///< Discards the updated range with glInvalidateBufferSubData before glBufferSubData. Requires Capabilities::invalidateSubdata, plain glBufferSubData otherwise.
+    MapInvalidate   ///< Writes through a map with MapUsage::InvalidateBuffer | MapUsage::Unsynchronized for the whole Buffer, MapUsage::InvalidRange for parts of it.
+};
+
 /**
  * @brief Converts a BufferType enum into a GLenum.
  * 
@@ -137,6 +158,11 @@ inline BufferFlag& operator|=(BufferFlag& a, BufferFlag b) {
  */
 unsigned int toGLenum(BufferType type);
 
+/**
+ * @brief Checks if the given BufferType has indexed binding points (AtomicCounter, ShaderStorage, TransformFeedback and Uniform).
+ */
+bool hasIndexedBindings(BufferType type);
+
 /**
  * @brief Converts a BufferUsage enum into a GLenum.
  * 
@@ -174,16 +200,66 @@ bool validateMapUsage(MapUsage usage, std::string& error);
  */
 bool validateBufferFlag(BufferFlag flag, std::string& error);
 
+/**
+ * @brief A range to copy from one Buffer to another, see Buffer::copyFrom.
+ */
+struct BufferCopyRegion {
+    int64_t srcOffset = 0;  ///< Offset into the source Buffer in bytes.
+    int64_t dstOffset = 0;  ///< Offset into the destination Buffer in bytes.
+    int64_t size = 0;       ///< Size of the range in bytes.
+};
+
+/**
+ * @brief Buffer class to abstract OpenGL buffer objects.
+ *
+ * @warning Buffer must be deconstructed before the OpenGL context is destroyed.
+ * @warning This class is not guaranteed to be thread-safe.
+ *
+ * @note When Capabilities::directStateAccess is available, edits to the Buffer never change any binding state.
+ *       Otherwise they bind the Buffer to the binding point of its BufferType.
+ * @note The OpenGL object is released through the gla::DeletionQueue of the context it was created in upon destruction.
+ * @note The data store is accounted in gla::MemoryTracker.
+ */
 class Buffer {
 protected:
     unsigned int _id = 0;
+    BufferType _type;
+    DeletionQueue* _deletionQueue = nullptr; // of the context the buffer object was created in
+
+    // client side shadow of the driver state, so validation never has to query OpenGL
+    int64_t _size = 0;
+    bool _immutable = false;
+    BufferUsage _usage = BufferUsage::StaticDraw;
+    BufferFlag _flags = BufferFlag::None;
     bool _mapped = false;
     MapUsage _mapUsage = MapUsage::None;
-    BufferFlag _flags = BufferFlag::None;
-    BufferType _type;
+    int64_t _mapOffset = 0;
+    int64_t _mapLength = 0;
+    void* _mapPointer = nullptr;
+
+    UpdatePolicy _updatePolicy = UpdatePolicy::SubData;
 
     void _delete();
     void _check();
+    void _resetMapping();
+    void _validateRange(int64_t offset, int64_t size) const;
+    void _validateCopy(const Buffer& src, const BufferCopyRegion& region) const;
+    void _clear(int64_t offset, int64_t size, unsigned int internalFormat, unsigned int format, unsigned int type, const void* value, int64_t valueSize);
+    static void _copy(const Buffer& src, int64_t srcOffset, Buffer& dst, int64_t dstOffset, int64_t size);
+
+    template <typename T, typename Generator>
+    void _generate(int64_t count, Generator& generator) {
+        if (count == 0)
+            return;
+        T* data = static_cast<T*>(map(0, _size, MapUsage::Write | MapUsage::InvalidateBuffer));
+        try {
+            generator(std::span<T>(data, static_cast<size_t>(count)));
+        } catch (...) {
+            unmap();
+            throw;
+        }
+        unmap();
+    }
 
 public:
     Buffer() = delete;
@@ -201,19 +277,120 @@ public:
     void bind() const;
 
     /**
-     * @brief Returns the size in bytes of the Buffer. 
+     * @brief Binds the whole Buffer to an indexed binding point of its BufferType.
+     *
+     * @throws std::logic_error If the BufferType has no indexed binding points
+     *
+     * @param index The index of the binding point, for example the binding of a uniform block
+     */
+    void bindBase(unsigned int index) const;
+
+    /**
+     * @brief Binds a range of the Buffer to an indexed binding point of its BufferType.
+     *
+     * @throws std::logic_error If the BufferType has no indexed binding points
+     * @throws std::runtime_error If offset is negativ
+     * @throws std::runtime_error If size is not greater than 0
+     * @throws std::runtime_error If offset + size is greater than the size of the Buffer
+     *
+     * @note offset must respect the offset alignment of the BufferType, for example GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT.
+     *
+     * @param index The index of the binding point, for example the binding of a uniform block
+     * @param offset The offset of the range in bytes
+     * @param size The size of the range in bytes
+     */
+    void bindRange(unsigned int index, int64_t offset, int64_t size) const;
+
+    /**
+     * @brief Binds a range of the Buffer to an indexed binding point of another BufferType.
+     *
+     * A Buffer may serve several targets, for example uniform blocks and shader storage blocks at once.
+     *
+     * @throws std::logic_error If type has no indexed binding points
+     * @throws std::runtime_error If the range is invalid, see bindRange(unsigned int, int64_t, int64_t)
+     *
+     * @param type The BufferType of the binding point
+     * @param index The index of the binding point
+     * @param offset The offset of the range in bytes
+     * @param size The size of the range in bytes
      */
-    int64_t size() const;
+    void bindRange(BufferType type, unsigned int index, int64_t offset, int64_t size) const;
+
+    /**
+     * @brief Binds slices to consecutive indexed binding points, with one glBindBuffersRange call if Capabilities::multiBind is available.
+     *
+     * @throws std::logic_error If type has no indexed binding points
+     * @throws std::logic_error If a slice does not refer to a Buffer
+     * @throws std::runtime_error If a slice is empty or outside of its Buffer
+     *
+     * @param type The BufferType of the binding points
+     * @param first The index of the first binding point
+     * @param slices The ranges to bind, slice i is bound to index first + i
+     */
+    static void bindRanges(BufferType type, unsigned int first, std::span<const BufferSlice> slices);
+
+    /**
+     * @brief Returns the size in bytes of the Buffer.
+     *
+     * @note Returns the client side shadow, no OpenGL query is made.
+     */
+    int64_t size() const { return _size; }
 
     /**
      * @brief Get the Type of the Buffer.
      */
     BufferType getType() const;
 
+    /**
+     * @brief Gets the usage hint given to the last setData, only meaningful if the storage is mutable.
+     */
+    BufferUsage getUsage() const { return _usage; }
+
+    /**
+     * @brief Gets the BufferFlags given to setStorage, BufferFlag::None for mutable storage.
+     */
+    BufferFlag getFlags() const { return _flags; }
+
+    /**
+     * @brief Checks if the storage was allocated with setStorage and therefore can't be re-specified.
+     */
+    bool immutable() const { return _immutable; }
+
+    bool mapped() const { return _mapped; }                 ///< Checks if the Buffer is currently mapped.
+    MapUsage getMapUsage() const { return _mapUsage; }      ///< Gets the MapUsage of the current mapping.
+    int64_t mapOffset() const { return _mapOffset; }        ///< Gets the offset of the current mapping in bytes.
+    int64_t mapLength() const { return _mapLength; }        ///< Gets the length of the current mapping in bytes.
+    void* mapPointer() const { return _mapPointer; }        ///< Gets the pointer returned by the current mapping, nullptr if not mapped.
+
+    /**
+     * @brief Selects how setSubData updates the Buffer.
+     *
+     * @note UpdatePolicy::Orphan only pays off when the whole Buffer is rewritten, partial updates and updates
+     *       while the Buffer is mapped fall back to plain glBufferSubData.
+     *
+     * @param policy The policy used by all following calls to setSubData
+     */
+    void setUpdatePolicy(UpdatePolicy policy) { _updatePolicy = policy; }
+
+    /**
+     * @brief Gets the policy used by setSubData.
+     */
+    UpdatePolicy getUpdatePolicy() const { return _updatePolicy; }
+
+    /**
+     * @brief Cross-checks the client side shadow against the state reported by the driver.
+     *
+     * @note Called after every state change when GLA_VALIDATE_SHADOW_STATE is defined. Issues several OpenGL queries.
+     *
+     * @throws std::logic_error If the shadow does not match the driver state
+     */
+    void validateShadowState() const;
+
     /**
      * @brief Set the data of the Buffer with a given usage.
      * 
      * @throws std::runtime_error If size is negative
+     * @throws std::runtime_error If the storage is immutable because it was allocated with setStorage
      * 
      * @param size The size of the data in bytes
      * @param data The data to store in the Buffer (must have at least size bytes of data)
@@ -224,17 +401,42 @@ public:
     /**
      * @brief Set the data of the Buffer with a given usage.
      * 
-     * @param data The data to store in the Buffer
+     * @param data The data to store in the Buffer, any contiguous range like std::vector, std::array or std::span (not copied)
      * @param usage The usage hint of the Buffer
      */
-    template <typename T>
-    void setData(std::vector<T> data, BufferUsage usage) { setData(data.size() * sizeof(T), (void*)data.data(), usage); }
+    template <std::ranges::contiguous_range R>
+        requires std::ranges::sized_range<R>
+    void setData(const R& data, BufferUsage usage) { setData(std::ranges::size(data) * sizeof(std::ranges::range_value_t<R>), std::ranges::data(data), usage); }
+
+    /**
+     * @brief Allocates the data of the Buffer and lets a generator write it straight into the mapped storage.
+     *
+     * @throws std::runtime_error If count is negative
+     * @throws std::runtime_error If the storage is immutable because it was allocated with setStorage
+     * @throws std::runtime_error If mapping failed
+     *
+     * @note The Buffer is unmapped again, even if the generator throws.
+     *
+     * @param count The number of elements of type T
+     * @param generator Callable invoked once with a std::span<T> over the whole storage, the previous contents are undefined
+     * @param usage The usage hint of the Buffer
+     */
+    template <typename T, std::invocable<std::span<T>> Generator>
+    void setData(int64_t count, Generator&& generator, BufferUsage usage) {
+        static_assert(std::is_trivially_copyable_v<T>, "Buffer data must be trivially copyable!");
+        if (count < 0)
+            throw std::runtime_error("count may not be negative!");
+        setData(count * static_cast<int64_t>(sizeof(T)), nullptr, usage);
+        _generate<T>(count, generator);
+    }
 
     /**
      * @brief Set the data of the Buffer with given Buffer flags.
      * 
      * @throws std::runtime_error If size is not greater than 0
      * @throws std::runtime_error If the BufferFlag combination is invalid
+     * @throws std::runtime_error If the storage is already immutable because setStorage was called before
+     * @throws std::runtime_error If BufferFlag::Sparse is set without Capabilities::sparseBuffer or with initial data
      * 
      * @param size The size of the data in bytes
      * @param data The data to store in the Buffer (must have at least size bytes of data)
@@ -247,20 +449,64 @@ public:
      * 
      * @throws std::runtime_error If size is not greater than 0
      * @throws std::runtime_error If the BufferFlag combination is invalid
+     * @throws std::runtime_error If the storage is already immutable because setStorage was called before
      * 
-     * @param data The data to store in the Buffer
+     * @param data The data to store in the Buffer, any contiguous range like std::vector, std::array or std::span (not copied)
      * @param flags The Buffer usage flags
      */
-    template <typename T>
-    void setStorage(std::vector<T> data, BufferFlag flags) { setStorage(data.size() * sizeof(T), (void*)data.data(), flags); }
+    template <std::ranges::contiguous_range R>
+        requires std::ranges::sized_range<R>
+    void setStorage(const R& data, BufferFlag flags) { setStorage(std::ranges::size(data) * sizeof(std::ranges::range_value_t<R>), std::ranges::data(data), flags); }
 
     /**
-     * @brief Set a subset of the data in the Buffer.
+     * @brief Allocates immutable storage and lets a generator write it straight into the mapped storage.
+     *
+     * @throws std::runtime_error If count is not greater than 0
+     * @throws std::runtime_error If BufferFlag::MapWrite is not set
+     * @throws std::runtime_error If the BufferFlag combination is invalid
+     * @throws std::runtime_error If the storage is already immutable because setStorage was called before
+     * @throws std::runtime_error If mapping failed
+     *
+     * @note The Buffer is unmapped again, even if the generator throws.
+     *
+     * @param count The number of elements of type T
+     * @param generator Callable invoked once with a std::span<T> over the whole storage, the previous contents are undefined
+     * @param flags The Buffer usage flags, must contain BufferFlag::MapWrite
+     */
+    template <typename T, std::invocable<std::span<T>> Generator>
+    void setStorage(int64_t count, Generator&& generator, BufferFlag flags) {
+        static_assert(std::is_trivially_copyable_v<T>, "Buffer data must be trivially copyable!");
+        if ((flags & BufferFlag::MapWrite) == BufferFlag::None)
+            throw std::runtime_error("Generating the data of immutable storage requires BufferFlag::MapWrite!");
+        setStorage(count * static_cast<int64_t>(sizeof(T)), nullptr, flags);
+        _generate<T>(count, generator);
+    }
+
+    /**
+     * @brief Commits or decommits physical pages of storage allocated with BufferFlag::Sparse.
+     *
+     * @warning Accessing uncommitted pages returns undefined data and discards writes.
+     *
+     * @throws std::logic_error If the storage was not allocated with BufferFlag::Sparse
+     * @throws std::runtime_error If the range is outside of the Buffer
+     * @throws std::runtime_error If offset or size is not a multiple of Capabilities::sparseBufferPageSize
+     *
+     * @param offset The offset of the first page in bytes
+     * @param size The size of the range in bytes
+     * @param commit true to commit the pages, false to release them
+     */
+    void commitPages(int64_t offset, int64_t size, bool commit);
+
+    /**
+     * @brief Set a subset of the data in the Buffer according to the UpdatePolicy.
      * 
      * @throws std::runtime_error If offset is negativ
      * @throws std::runtime_error If size is negativ
      * @throws std::runtime_error If offset + size is greater than the size of the Buffer
      * @throws std::runtime_error If the Buffer is mapped and MapUsage::Persistent is not set
+     * @throws std::runtime_error If the storage is immutable and BufferFlag::DynamicStorage is not set (BufferFlag::MapWrite for UpdatePolicy::MapInvalidate)
+     * @throws std::runtime_error If the UpdatePolicy is UpdatePolicy::Orphan and the storage is immutable
+     * @throws std::runtime_error If the UpdatePolicy is UpdatePolicy::MapInvalidate and the Buffer is mapped
      * 
      * @param offset The offset of the start of the subset to set in bytes
      * @param size The size of the subset to set in bytes
@@ -282,6 +528,97 @@ public:
      */
     void getSubData(int64_t offset, int64_t size, void* data);
 
+    /**
+     * @brief Reads a subset of the data in the Buffer without stalling the pipeline.
+     *
+     * The range is copied into the staging memory of the queue on the GPU, the returned Readback becomes ready
+     * once the copy has finished and ReadbackQueue::poll was called. Only blocks if the queue is full.
+     *
+     * @throws std::runtime_error If offset is negativ
+     * @throws std::runtime_error If size is not greater than 0
+     * @throws std::runtime_error If offset + size is greater than the size of the Buffer
+     * @throws std::runtime_error If the Buffer is mapped and MapUsage::Persistent is not set
+     * @throws std::invalid_argument If size is greater than the capacity of the queue
+     *
+     * @param offset The offset of the start of the subset to read in bytes
+     * @param size The size of the subset to read in bytes
+     * @param queue The ReadbackQueue providing the staging memory
+     *
+     * @returns A handle to the data of the subset
+     */
+    Readback readAsync(int64_t offset, int64_t size, ReadbackQueue& queue) const;
+
+    /**
+     * @brief Streams a range of a file into the Buffer without reading it into client memory first.
+     *
+     * The file is memory mapped one window at a time and copied chunk by chunk through persistently mapped staging
+     * memory, chunks are recycled as soon as the GPU has passed the Fence of their copy. Returns once the GPU has
+     * finished all copies.
+     *
+     * @note If the Buffer has no storage yet, mutable storage of the loaded size is allocated with BufferUsage::StaticDraw.
+     *
+     * @throws std::invalid_argument If the options are invalid (chunkSize or chunksInFlight is 0, windowSize is less than chunkSize)
+     * @throws std::runtime_error If the file could not be opened or mapped
+     * @throws std::runtime_error If the file range is outside of the file
+     * @throws std::runtime_error If the destination range is outside of the Buffer
+     * @throws std::runtime_error If the Buffer is mapped and MapUsage::Persistent is not set
+     *
+     * @param path The path of the file
+     * @param fileOffset The offset of the range into the file in bytes
+     * @param length The length of the range in bytes, -1 for everything after fileOffset
+     * @param dstOffset The offset into the Buffer in bytes
+     * @param options The chunk and window sizes
+     *
+     * @returns The statistics of the load, including the throughput
+     */
+    FileLoadStats loadFromFile(const std::string& path, int64_t fileOffset = 0, int64_t length = -1, int64_t dstOffset = 0, const FileLoadOptions& options = {});
+
+    /**
+     * @brief Copies a range of another Buffer (or of this one) into the Buffer on the GPU.
+     *
+     * @throws std::runtime_error If an offset is negativ or size is negativ
+     * @throws std::runtime_error If a range is outside of its Buffer
+     * @throws std::runtime_error If src is this Buffer and the ranges overlap
+     * @throws std::runtime_error If one of the Buffers is mapped and MapUsage::Persistent is not set
+     *
+     * @param src The Buffer to copy from
+     * @param srcOffset The offset into src in bytes
+     * @param dstOffset The offset into this Buffer in bytes
+     * @param size The size of the range in bytes
+     */
+    void copyFrom(const Buffer& src, int64_t srcOffset, int64_t dstOffset, int64_t size);
+
+    /**
+     * @brief Copies several ranges of another Buffer (or of this one) into the Buffer on the GPU.
+     *
+     * All regions are validated before the first copy is issued and the Buffers are bound only once.
+     * Copies are executed in order, so later regions may read what earlier ones wrote.
+     *
+     * @throws std::runtime_error If any region is invalid, see copyFrom
+     *
+     * @param src The Buffer to copy from
+     * @param regions The ranges to copy
+     */
+    void copyFrom(const Buffer& src, std::span<const BufferCopyRegion> regions);
+
+    /**
+     * @brief Fills a range of the Buffer with a repeated value on the GPU, without uploading any data.
+     *
+     * @throws std::runtime_error If offset is negativ
+     * @throws std::runtime_error If offset + size is greater than the size of the Buffer
+     * @throws std::runtime_error If offset or size is not a multiple of the size of the value
+     * @throws std::runtime_error If the Buffer is mapped and MapUsage::Persistent is not set
+     *
+     * @param value The value to repeat
+     * @param offset The offset of the range in bytes
+     * @param size The size of the range in bytes, -1 for everything after offset
+     */
+    void fill(uint8_t value, int64_t offset = 0, int64_t size = -1);
+    void fill(uint16_t value, int64_t offset = 0, int64_t size = -1);   ///< See fill(uint8_t, int64_t, int64_t).
+    void fill(uint32_t value, int64_t offset = 0, int64_t size = -1);   ///< See fill(uint8_t, int64_t, int64_t).
+    void fill(int32_t value, int64_t offset = 0, int64_t size = -1);    ///< See fill(uint8_t, int64_t, int64_t).
+    void fill(float value, int64_t offset = 0, int64_t size = -1);      ///< See fill(uint8_t, int64_t, int64_t).
+
     /**
      * @brief Map a part of the Buffer data to the client's address space.
      * 
@@ -291,6 +628,7 @@ public:
      * @throws std::runtime_error If length + offset is greater than the size of the Buffer
      * @throws std::runtime_error If the MapUsage is invalid
      * @throws std::runtime_error If MapUsage::Persistent was requested without BufferFlag::MapPersistent being set through setStorage
+     * @throws std::runtime_error If MapUsage::Read or MapUsage::Write was requested on immutable storage without the matching BufferFlag
      * @throws std::runtime_error If mapping failed and a nullptr was returned
      * 
      * @param offset The offset of the map range into the Buffer in bytes
@@ -301,17 +639,110 @@ public:
      */
     void* map(int64_t offset, int64_t length, MapUsage access);
 
+    /**
+     * @brief Flushes modifications of a subrange of a mapping made with MapUsage::FlushExplicit.
+     *
+     * @throws std::runtime_error If the Buffer is not mapped with MapUsage::FlushExplicit
+     * @throws std::runtime_error If offset is negativ
+     * @throws std::runtime_error If length is negativ
+     * @throws std::runtime_error If offset + length is greater than the length of the mapping
+     *
+     * @note See gla::MappedView to track and coalesce the ranges automatically.
+     *
+     * @param offset The offset of the range relative to the start of the mapping in bytes
+     * @param length The length of the range in bytes
+     */
+    void flushMappedRange(int64_t offset, int64_t length);
+
     /**
      * @brief Unmaps the Buffer.
      * 
+     * @throws std::runtime_error If the Buffer is not mapped
      * @throws std::runtime_error If OpenGL signalled data corruption
      */
     void unmap();
 
+    friend class VertexArrayObject;
+
     Buffer& operator=(Buffer&& other);
     Buffer& operator=(const Buffer& other) = delete;
 };
 
+/**
+ * @brief Lightweight non-owning view of a range inside a Buffer.
+ *
+ * Offsets passed to the methods are relative to the start of the slice.
+ *
+ * @warning The Buffer must outlive the BufferSlice.
+ */
+struct BufferSlice {
+    Buffer* buffer = nullptr;   ///< The Buffer the slice lives in.
+    int64_t offset = 0;         ///< Offset of the slice into the Buffer in bytes.
+    int64_t size = 0;           ///< Size of the slice in bytes.
+    uint64_t handle = 0;        ///< Opaque handle of the allocator that handed out the slice.
+
+    /**
+     * @brief Checks if the slice refers to a Buffer.
+     */
+    bool valid() const { return buffer != nullptr; }
+
+    /**
+     * @brief Set a subset of the data in the slice, see Buffer::setSubData.
+     *
+     * @throws std::out_of_range If offset + size is greater than the size of the slice
+     */
+    void setSubData(int64_t offset, int64_t size, const void* data) const { _check(offset, size); buffer->setSubData(this->offset + offset, size, data); }
+
+    /**
+     * @brief Get a subset of the data in the slice, see Buffer::getSubData.
+     *
+     * @throws std::out_of_range If offset + size is greater than the size of the slice
+     */
+    void getSubData(int64_t offset, int64_t size, void* data) const { _check(offset, size); buffer->getSubData(this->offset + offset, size, data); }
+
+    /**
+     * @brief Map a part of the slice to the client's address space, see Buffer::map.
+     *
+     * @throws std::out_of_range If offset + length is greater than the size of the slice
+     */
+    void* map(int64_t offset, int64_t length, MapUsage access) const { _check(offset, length); return buffer->map(this->offset + offset, length, access); }
+
+private:
+    void _check(int64_t offset, int64_t size) const {
+        if (buffer == nullptr)
+            throw std::logic_error("BufferSlice does not refer to a Buffer!");
+        if (offset < 0 || size < 0 || offset + size > this->size)
+            throw std::out_of_range("Range is outside of the BufferSlice!");
+    }
+};
+
+/**
+ * @brief A variable-sized record stored in a Buffer, see compactBuffer.
+ */
+struct BufferRecord {
+    int64_t offset = 0; ///< Offset of the record in bytes.
+    int64_t size = 0;   ///< Size of the record in bytes.
+};
+
+/**
+ * @brief Defragments a Buffer holding variable-sized records by moving them towards the start with GPU copies only.
+ *
+ * Records keep their relative order. Records that overlap their new location are moved in non-overlapping pieces.
+ * If a record moves by less than 64 KB, it bounces through a scratch Buffer of at most 1 MB instead, so a small gap
+ * in front of a large record never turns into millions of copies.
+ *
+ * @throws std::invalid_argument If alignment is not greater than 0
+ * @throws std::invalid_argument If a record offset is not a multiple of alignment
+ * @throws std::invalid_argument If records overlap each other or lie outside of the Buffer
+ *
+ * @param buffer The Buffer to compact
+ * @param records The live records, their offsets are updated to the new locations
+ * @param alignment The alignment of the new offsets in bytes
+ *
+ * @returns The number of bytes used after compaction, everything behind it is free
+ */
+int64_t compactBuffer(Buffer& buffer, std::span<BufferRecord> records, int64_t alignment = 1);
+
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,129 @@
+#ifndef GLA_BUFFER_CACHE_H
+#define GLA_BUFFER_CACHE_H
+
+#include <compare>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <ranges>
+#include <stdexcept>
+
+#include <GLA/buffer.h>
+#include <GLA/hash.h>
+
+namespace gla {
+
+/**
+ * @brief Metrics of a BufferCache.
+ */
+struct BufferCacheStats {
+    uint64_t hits = 0;          ///< Number of uploads served by an existing Buffer.
+    uint64_t misses = 0;        ///< Number of uploads that created a new Buffer.
+    uint64_t bytesSaved = 0;    ///< Number of bytes not uploaded thanks to hits.
+    uint64_t bytesUploaded = 0; ///< Number of bytes uploaded on misses.
+
+    /**
+     * @brief Gets the ratio of uploads served by existing Buffers in [0;1].
+     */
+    double hitRate() const { return hits + misses > 0 ? (double)hits / (double)(hits + misses) : 0.0; }
+};
+
+/**
+ * @brief Deduplicates static Buffers by the hash of their contents.
+ *
+ * get() hashes the data with hash128 and returns the live Buffer created for identical data, BufferType and
+ * usage or flags if there is one, otherwise it uploads a new Buffer. Buffers are reference counted and destroyed
+ * when the last user releases them, the cache only keeps weak references.
+ *
+ * @warning BufferCache must be deconstructed before the OpenGL context is destroyed.
+ * @warning This class is not guaranteed to be thread-safe.
+ *
+ * @note The Buffers are shared, so they are handed out as const and must not be modified.
+ */
+class BufferCache {
+protected:
+    struct _Key {
+        Hash128 hash;
+        int64_t size;
+        BufferType type;
+        bool immutable;
+        uint32_t mode; // BufferUsage or BufferFlag
+
+        auto operator<=>(const _Key& other) const = default;
+    };
+
+    std::map<_Key, std::weak_ptr<Buffer>> _entries = {};
+    BufferCacheStats _stats = {};
+
+    std::shared_ptr<const Buffer> _get(const _Key& key, const void* data);
+
+public:
+    BufferCache() = default;
+    BufferCache(BufferCache&& other) = default;
+    BufferCache(const BufferCache& other) = delete;
+
+    /**
+     * @brief Gets a Buffer with mutable storage holding the given data, shared with identical uploads.
+     *
+     * @throws std::runtime_error If size is negative
+     *
+     * @param type The BufferType of the Buffer
+     * @param size The size of the data in bytes
+     * @param data The data (must have at least size bytes of data)
+     * @param usage The usage hint of the Buffer
+     */
+    std::shared_ptr<const Buffer> get(BufferType type, int64_t size, const void* data, BufferUsage usage = BufferUsage::StaticDraw);
+
+    /**
+     * @brief Gets a Buffer with immutable storage holding the given data, shared with identical uploads.
+     *
+     * @throws std::runtime_error If size is not greater than 0
+     * @throws std::runtime_error If the BufferFlag combination is invalid
+     *
+     * @param type The BufferType of the Buffer
+     * @param size The size of the data in bytes
+     * @param data The data (must have at least size bytes of data)
+     * @param flags The Buffer usage flags
+     */
+    std::shared_ptr<const Buffer> get(BufferType type, int64_t size, const void* data, BufferFlag flags);
+
+    /**
+     * @brief Gets a Buffer with mutable storage holding the given range, shared with identical uploads.
+     *
+     * @param type The BufferType of the Buffer
+     * @param data Any contiguous range like std::vector, std::array or std::span
+     * @param usage The usage hint of the Buffer
+     */
+    template <std::ranges::contiguous_range R>
+        requires std::ranges::sized_range<R>
+    std::shared_ptr<const Buffer> get(BufferType type, const R& data, BufferUsage usage = BufferUsage::StaticDraw) {
+        return get(type, std::ranges::size(data) * sizeof(std::ranges::range_value_t<R>), std::ranges::data(data), usage);
+    }
+
+    /**
+     * @brief Removes the entries of Buffers that have been destroyed.
+     */
+    void prune();
+
+    /**
+     * @brief Gets the number of entries, including ones whose Buffer was destroyed since the last prune().
+     */
+    size_t entries() const { return _entries.size(); }
+
+    /**
+     * @brief Gets the metrics.
+     */
+    const BufferCacheStats& stats() const { return _stats; }
+
+    /**
+     * @brief Resets the metrics.
+     */
+    void resetStats() { _stats = {}; }
+
+    BufferCache& operator=(BufferCache&& other) = default;
+    BufferCache& operator=(const BufferCache& other) = delete;
+};
+
+}
+
+#endif
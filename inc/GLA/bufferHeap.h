@@ -0,0 +1,115 @@
+#ifndef GLA_BUFFER_HEAP_H
+#define GLA_BUFFER_HEAP_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <stdexcept>
+
+#include <GLA/buffer.h>
+#include <GLA/offsetAllocator.h>
+
+namespace gla {
+
+/**
+ * @brief Usage and fragmentation statistics of a BufferHeap.
+ */
+struct BufferHeapStats {
+    uint32_t blocks = 0;            ///< Number of Buffers owned by the heap.
+    uint32_t allocations = 0;       ///< Number of live BufferSlices.
+    uint32_t freeRegions = 0;       ///< Number of separate free ranges over all blocks.
+    int64_t reservedBytes = 0;      ///< Total size of all blocks.
+    int64_t usedBytes = 0;          ///< Bytes handed out (including alignment padding).
+    int64_t freeBytes = 0;          ///< Bytes not handed out.
+    int64_t largestFreeRegion = 0;  ///< Largest range that can be allocated without creating a new block.
+
+    /**
+     * @brief Gets the external fragmentation in [0;1], 0 meaning all free bytes are in one range.
+     */
+    double fragmentation() const { return freeBytes > 0 ? 1.0 - (double)largestFreeRegion / (double)freeBytes : 0.0; }
+};
+
+/**
+ * @brief Sub-allocates BufferSlices from a few large Buffers.
+ *
+ * Every block is a Buffer created through Buffer::setStorage and carved up by an OffsetAllocator,
+ * so allocating and freeing never creates or deletes OpenGL objects unless a new block is needed.
+ * Slices that are bigger than the block size get a dedicated block.
+ *
+ * @warning BufferHeap must be deconstructed before the OpenGL context is destroyed.
+ * @warning This class is not guaranteed to be thread-safe.
+ *
+ * @note All slice offsets are multiples of the heap alignment.
+ */
+class BufferHeap {
+protected:
+    struct _Block {
+        Buffer buffer;
+        OffsetAllocator allocator;
+    };
+
+    BufferType _type;
+    BufferFlag _flags;
+    int64_t _blockSize;
+    int64_t _alignment;
+    std::vector<std::unique_ptr<_Block>> _blocks = {}; // unique_ptr keeps the Buffer addresses stable
+
+    uint32_t _createBlock(int64_t size);
+
+public:
+    BufferHeap() = delete;
+    /**
+     * @brief Construct a new BufferHeap, no block is allocated until the first allocate().
+     *
+     * @throws std::invalid_argument If alignment is not a power of two
+     * @throws std::invalid_argument If blockSize is less than alignment
+     * @throws std::runtime_error If the BufferFlag combination is invalid
+     *
+     * @param type The binding point of the blocks
+     * @param blockSize The size of each block in bytes (rounded up to the alignment)
+     * @param flags The flags used for Buffer::setStorage of each block
+     * @param alignment The alignment of every slice offset in bytes (256 satisfies all uniform and storage buffer alignments in practice)
+     */
+    BufferHeap(BufferType type, int64_t blockSize, BufferFlag flags = BufferFlag::DynamicStorage, int64_t alignment = 256);
+    BufferHeap(BufferHeap&& other) = default;
+    BufferHeap(const BufferHeap& other) = delete;
+
+    /**
+     * @brief Allocates a slice of at least size bytes.
+     *
+     * @throws std::invalid_argument If size is not greater than 0
+     * @throws std::runtime_error If a new block could not be created
+     *
+     * @returns A slice, BufferSlice::size is rounded up to the alignment
+     */
+    BufferSlice allocate(int64_t size);
+
+    /**
+     * @brief Returns a slice to the heap and resets it.
+     *
+     * @throws std::invalid_argument If the slice was not allocated by this heap or was already freed
+     */
+    void free(BufferSlice& slice);
+
+    /**
+     * @brief Deletes all blocks that hold no allocations.
+     */
+    void trim();
+
+    /**
+     * @brief Gets usage and fragmentation statistics.
+     */
+    BufferHeapStats stats() const;
+
+    BufferType getType() const { return _type; }        ///< Gets the binding point of the blocks.
+    BufferFlag getFlags() const { return _flags; }      ///< Gets the storage flags of the blocks.
+    int64_t blockSize() const { return _blockSize; }    ///< Gets the default block size in bytes.
+    int64_t alignment() const { return _alignment; }    ///< Gets the alignment of all slice offsets in bytes.
+
+    BufferHeap& operator=(BufferHeap&& other) = default;
+    BufferHeap& operator=(const BufferHeap& other) = delete;
+};
+
+}
+
+#endif
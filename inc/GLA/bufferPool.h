@@ -0,0 +1,167 @@
+#ifndef GLA_BUFFER_POOL_H
+#define GLA_BUFFER_POOL_H
+
+#include <compare>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <GLA/buffer.h>
+#include <GLA/fence.h>
+
+namespace gla {
+
+/**
+ * @brief Retention limits of a BufferPool, idle Buffers over the limits are destroyed in BufferPool::endFrame.
+ */
+struct BufferPoolLimits {
+    uint32_t maxBuffersPerClass = 8;        ///< Maximum number of idle Buffers per BufferType, usage / flags and size class.
+    int64_t maxBytes = 64ll * 1024 * 1024;  ///< Maximum number of bytes held by idle Buffers.
+    uint64_t maxIdleFrames = 120;           ///< Number of frames after which an unused idle Buffer is destroyed.
+};
+
+/**
+ * @brief Statistics of a BufferPool.
+ */
+struct BufferPoolStats {
+    uint64_t hits = 0;          ///< Number of acquires served by a recycled Buffer.
+    uint64_t misses = 0;        ///< Number of acquires that had to create a new Buffer.
+    uint64_t releases = 0;      ///< Number of Buffers given back to the pool.
+    uint64_t evictions = 0;     ///< Number of idle Buffers destroyed because of the retention limits.
+    uint32_t idleBuffers = 0;   ///< Number of Buffers ready to be acquired.
+    int64_t idleBytes = 0;      ///< Number of bytes held by idle Buffers.
+    uint32_t inFlight = 0;      ///< Number of released Buffers waiting for the GPU.
+
+    /**
+     * @brief Gets the ratio of acquires served by recycled Buffers in [0;1].
+     */
+    double hitRate() const { return hits + misses > 0 ? (double)hits / (double)(hits + misses) : 0.0; }
+};
+
+/**
+ * @brief Recycles Buffers of equal BufferType, usage or flags and power of two size class.
+ *
+ * acquire() hands out an idle Buffer of the matching class or creates a new one, release() gives it back.
+ * Released Buffers are guarded by a Fence in endFrame() and only handed out again once the GPU has passed it,
+ * so they can be overwritten without synchronization.
+ *
+ * @warning BufferPool must be deconstructed before the OpenGL context is destroyed.
+ * @warning This class is not guaranteed to be thread-safe.
+ *
+ * @note Call endFrame() once per frame after the draws using the released Buffers have been issued.
+ * @note The size of an acquired Buffer is the size class, which is at least the requested size.
+ */
+class BufferPool {
+protected:
+    static constexpr int64_t _MIN_SIZE = 256;
+
+    struct _Key {
+        BufferType type;
+        bool immutable;
+        uint32_t mode; // BufferUsage or BufferFlag
+        int64_t size;
+
+        auto operator<=>(const _Key& other) const = default;
+    };
+
+    struct _Idle {
+        Buffer buffer;
+        uint64_t lastUsedFrame;
+    };
+
+    struct _Batch {
+        Fence fence;
+        std::vector<std::pair<_Key, Buffer>> buffers;
+    };
+
+    BufferPoolLimits _limits;
+    uint64_t _frame = 0;
+    std::map<_Key, std::deque<_Idle>> _idle = {}; // most recently used at the back
+    std::vector<std::pair<_Key, Buffer>> _released = {};
+    std::deque<_Batch> _inFlight = {};
+    BufferPoolStats _stats = {};
+
+    static int64_t _sizeClass(int64_t size);
+    Buffer _acquire(const _Key& key);
+    void _evict(std::map<_Key, std::deque<_Idle>>::iterator it);
+
+public:
+    /**
+     * @brief Construct a new BufferPool.
+     *
+     * @param limits The retention limits
+     */
+    BufferPool(BufferPoolLimits limits = {});
+    BufferPool(BufferPool&& other) = default;
+    BufferPool(const BufferPool& other) = delete;
+
+    /**
+     * @brief Gets a Buffer with mutable storage of at least the given size.
+     *
+     * @throws std::invalid_argument If size is not greater than 0
+     *
+     * @param type The BufferType of the Buffer
+     * @param size The minimum size in bytes
+     * @param usage The usage hint of the storage
+     *
+     * @returns A Buffer with undefined contents
+     */
+    Buffer acquire(BufferType type, int64_t size, BufferUsage usage);
+
+    /**
+     * @brief Gets a Buffer with immutable storage of at least the given size.
+     *
+     * @throws std::invalid_argument If size is not greater than 0
+     * @throws std::runtime_error If the BufferFlag combination is invalid
+     *
+     * @param type The BufferType of the Buffer
+     * @param size The minimum size in bytes
+     * @param flags The Buffer usage flags of the storage
+     *
+     * @returns A Buffer with undefined contents, persistently mapped Buffers stay mapped
+     */
+    Buffer acquire(BufferType type, int64_t size, BufferFlag flags);
+
+    /**
+     * @brief Gives a Buffer back to the pool, it may still be in use by the GPU.
+     *
+     * @note Buffers that don't fit a size class, for example ones not created by a pool, are destroyed instead.
+     *
+     * @param buffer The Buffer to recycle
+     */
+    void release(Buffer&& buffer);
+
+    /**
+     * @brief Fences the Buffers released during the frame, makes the ones the GPU has finished available and
+     *        destroys idle Buffers over the retention limits.
+     */
+    void endFrame();
+
+    /**
+     * @brief Destroys all idle Buffers, Buffers still in flight are kept.
+     */
+    void clear();
+
+    const BufferPoolLimits& limits() const { return _limits; }              ///< Gets the retention limits.
+    void setLimits(const BufferPoolLimits& limits) { _limits = limits; }    ///< Sets the retention limits, applied in the next endFrame().
+
+    /**
+     * @brief Gets the statistics.
+     */
+    const BufferPoolStats& stats() const { return _stats; }
+
+    /**
+     * @brief Resets the counters, the gauges of idle and in flight Buffers are kept.
+     */
+    void resetStats() { _stats = { .idleBuffers = _stats.idleBuffers, .idleBytes = _stats.idleBytes, .inFlight = _stats.inFlight }; }
+
+    BufferPool& operator=(BufferPool&& other) = default;
+    BufferPool& operator=(const BufferPool& other) = delete;
+};
+
+}
+
+#endif
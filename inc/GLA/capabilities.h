@@ -0,0 +1,44 @@
+#ifndef GLA_CAPABILITIES_H
+#define GLA_CAPABILITIES_H
+
+#include <cstdint>
+
+namespace gla {
+
+/**
+ * @brief Optional OpenGL features that select between code paths of the abstraction.
+ */
+struct Capabilities {
+    bool directStateAccess = false; ///< OpenGL 4.5 or ARB_direct_state_access, objects are edited without binding them.
+    bool invalidateSubdata = false; ///< OpenGL 4.3 or ARB_invalidate_subdata, Buffer contents can be discarded explicitly.
+    bool multiBind = false;         ///< OpenGL 4.4 or ARB_multi_bind, several indexed Buffer bindings are set in one call.
+    bool sparseBuffer = false;      ///< ARB_sparse_buffer, Buffers may reserve address space and commit pages on demand.
+    bool gpuMemoryInfo = false;     ///< NVX_gpu_memory_info, the driver reports dedicated and available video memory.
+    bool memInfo = false;           ///< ATI_meminfo, the driver reports free video memory.
+    bool vertexAttribBinding = false; ///< OpenGL 4.3 or ARB_vertex_attrib_binding, vertex formats are separated from their Buffers.
+    bool primitiveRestartFixedIndex = false; ///< OpenGL 4.3 or ARB_ES3_compatibility, the restart index follows the index type.
+
+    int64_t uniformBufferOffsetAlignment = 256;         ///< GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, offsets of uniform Buffer ranges must be multiples of it.
+    int64_t shaderStorageBufferOffsetAlignment = 256;   ///< GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, offsets of shader storage Buffer ranges must be multiples of it.
+    int64_t sparseBufferPageSize = 65536;               ///< GL_SPARSE_BUFFER_PAGE_SIZE_ARB, granularity of Buffer::commitPages.
+    int maxVertexAttribs = 16;                          ///< GL_MAX_VERTEX_ATTRIBS, number of vertex attribute locations (at least 16 are guaranteed).
+    int maxVertexAttribBindings = 16;                   ///< GL_MAX_VERTEX_ATTRIB_BINDINGS, number of vertex Buffer binding indices (at least 16 are guaranteed).
+};
+
+/**
+ * @brief Queries the Capabilities of the current OpenGL context.
+ *
+ * @note Called by gla::WindowContext after GLEW has been initialized, only needed when managing the context manually.
+ */
+void queryCapabilities();
+
+/**
+ * @brief Gets the Capabilities queried by the last call to queryCapabilities.
+ *
+ * @note Returns all features as unsupported if queryCapabilities was never called.
+ */
+const Capabilities& capabilities();
+
+}
+
+#endif
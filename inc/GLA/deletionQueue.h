@@ -0,0 +1,139 @@
+#ifndef GLA_DELETION_QUEUE_H
+#define GLA_DELETION_QUEUE_H
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+#include <GLA/fence.h>
+
+namespace gla {
+
+/**
+ * @brief Enum to indicate the kind of OpenGL object handed to the DeletionQueue.
+ */
+enum class DeletionType {
+    Buffer,     ///< glDeleteBuffers
+    Shader,     ///< glDeleteShader
+    Program,    ///< glDeleteProgram
+    VertexArray ///< glDeleteVertexArrays
+};
+
+/**
+ * @brief Metrics of a DeletionQueue.
+ */
+struct DeletionQueueStats {
+    uint64_t queueDepth = 0;        ///< Number of objects waiting to be deleted.
+    uint64_t deferred = 0;          ///< Total number of objects pushed while the queue was enabled.
+    uint64_t retired = 0;           ///< Total number of objects deleted by the queue.
+    uint64_t retiredLastFrame = 0;  ///< Number of objects deleted by the last endFrame().
+    uint32_t framesInFlight = 0;    ///< Number of frames whose objects wait for their Fence.
+};
+
+/**
+ * @brief Defers the deletion of OpenGL objects until the GPU has finished the frame they were released in.
+ *
+ * Every OpenGL context has its own queue, because object names are only valid in the context that created them.
+ * Buffer, Shader, Program and VertexArrayObject remember the queue that was current when they were created and push
+ * their object into it upon destruction instead of deleting it, which avoids stalls on objects the GPU is still using
+ * and allows destroying them on any thread. endFrame() guards everything pushed during the frame with a Fence and
+ * deletes the objects of earlier frames whose Fence has been passed.
+ *
+ * gla::WindowContext owns an enabled queue, makes it current in WindowContext::useContext, calls endFrame() in
+ * WindowContext::swapBuffers and drains it on destruction.
+ *
+ * @warning While the queue is disabled, push() deletes immediately and may therefore only be called on the thread the
+ *          OpenGL context is current on.
+ * @warning endFrame() and drain() must be called on the thread the OpenGL context is current on.
+ *
+ * @note push() and stats() are thread-safe.
+ */
+class DeletionQueue {
+protected:
+    struct _Entry {
+        DeletionType type;
+        unsigned int id;
+    };
+
+    struct _Frame {
+        Fence fence;
+        std::vector<_Entry> entries;
+    };
+
+    mutable std::mutex _mutex;
+    bool _enabled = false;
+    std::vector<_Entry> _pending = {};
+    std::deque<_Frame> _frames = {};
+    DeletionQueueStats _stats = {};
+
+    static void _destroy(const _Entry& entry);
+    void _retire(_Frame& frame);
+
+public:
+    DeletionQueue() = default;
+    DeletionQueue(const DeletionQueue& other) = delete;
+    DeletionQueue(DeletionQueue&& other) = delete;
+    ~DeletionQueue() = default;
+
+    /**
+     * @brief Gets the DeletionQueue of the context current on the calling thread.
+     *
+     * @note If no queue was made current, a process wide disabled queue is returned, which deletes immediately.
+     */
+    static DeletionQueue& current();
+
+    /**
+     * @brief Makes the given queue the current one of the calling thread.
+     *
+     * @param queue The queue to make current, nullptr to use the disabled fallback queue
+     */
+    static void makeCurrent(DeletionQueue* queue);
+
+    /**
+     * @brief Checks if the given queue is the current one of the calling thread.
+     */
+    static bool isCurrent(const DeletionQueue* queue);
+
+    /**
+     * @brief Hands an object over for deletion, may be called from any thread while the queue is enabled.
+     *
+     * @param type The kind of object
+     * @param id The OpenGL name of the object, 0 is ignored
+     */
+    void push(DeletionType type, unsigned int id);
+
+    /**
+     * @brief Fences the objects pushed since the last call and deletes the ones whose frame the GPU has finished.
+     */
+    void endFrame();
+
+    /**
+     * @brief Deletes all queued objects immediately without waiting for the GPU.
+     */
+    void drain();
+
+    /**
+     * @brief Enables or disables deferring, disabling drains the queue.
+     */
+    void setEnabled(bool enabled);
+
+    /**
+     * @brief Checks if deletions are currently deferred.
+     */
+    bool enabled() const;
+
+    /**
+     * @brief Gets the metrics.
+     */
+    DeletionQueueStats stats() const;
+};
+
+/**
+ * @brief Gets the DeletionQueue of the context current on the calling thread, see DeletionQueue::current.
+ */
+DeletionQueue& deletionQueue();
+
+}
+
+#endif
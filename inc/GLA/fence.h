@@ -0,0 +1,88 @@
+#ifndef GLA_FENCE_H
+#define GLA_FENCE_H
+
+#include <cstdint>
+#include <stdexcept>
+
+namespace gla {
+
+/**
+ * @brief Fence class to abstract OpenGL sync objects.
+ *
+ * A Fence is inserted into the OpenGL command stream and becomes signaled once the GPU
+ * has executed every command issued before it.
+ *
+ * @warning Fence must be deconstructed before the OpenGL context is destroyed.
+ * @warning This class is not guaranteed to be thread-safe.
+ *
+ * @note This class owns the underlying OpenGL sync object and
+ *       releases it upon destruction, reset() or insert().
+ */
+class Fence {
+protected:
+    void* _sync = nullptr; // GLsync
+
+    void _delete();
+
+public:
+    /**
+     * @brief Construct an empty Fence, which counts as signaled.
+     */
+    Fence() = default;
+    Fence(Fence&& other);
+    Fence(const Fence& other) = delete; // OpenGL sync objects are not copy safe
+    ~Fence() noexcept;
+
+    /**
+     * @brief Inserts a new fence into the OpenGL command stream, replacing the current one.
+     *
+     * @throws std::runtime_error If OpenGL failed to create a sync object.
+     */
+    void insert();
+
+    /**
+     * @brief Releases the sync object and returns to the empty state.
+     */
+    void reset();
+
+    /**
+     * @brief Checks if the Fence holds a sync object.
+     */
+    bool valid() const { return _sync != nullptr; }
+
+    /**
+     * @brief Polls the Fence without blocking.
+     *
+     * @throws std::runtime_error If OpenGL failed to query the sync object.
+     *
+     * @returns true if the Fence is empty or the GPU has passed it, false otherwise.
+     */
+    bool signaled() const;
+
+    /**
+     * @brief Blocks until the GPU has passed the Fence or the timeout expired.
+     *
+     * @note Flushes the command stream so the Fence is guaranteed to be reached eventually.
+     *
+     * @throws std::runtime_error If OpenGL failed to wait on the sync object.
+     *
+     * @param timeout The maximum time to wait in nanoseconds
+     *
+     * @returns true if the Fence has been signaled, false if the timeout expired.
+     */
+    bool wait(uint64_t timeout);
+
+    /**
+     * @brief Blocks until the GPU has passed the Fence.
+     *
+     * @throws std::runtime_error If OpenGL failed to wait on the sync object.
+     */
+    void wait();
+
+    Fence& operator=(Fence&& other);
+    Fence& operator=(const Fence& other) = delete; // OpenGL sync objects are not copy safe
+};
+
+}
+
+#endif
@@ -0,0 +1,109 @@
+#ifndef GLA_FILE_MAPPING_H
+#define GLA_FILE_MAPPING_H
+
+#include <cstdint>
+#include <string>
+#include <stdexcept>
+
+namespace gla {
+
+/**
+ * @brief Options of Buffer::loadFromFile.
+ */
+struct FileLoadOptions {
+    int64_t chunkSize = 4ll * 1024 * 1024;      ///< Size of the pieces copied through the staging memory in bytes.
+    uint32_t chunksInFlight = 4;                ///< Number of chunks the GPU may still be copying while the next ones are filled.
+    int64_t windowSize = 64ll * 1024 * 1024;    ///< Maximum size of the file range mapped at once in bytes.
+};
+
+/**
+ * @brief Statistics returned by Buffer::loadFromFile.
+ */
+struct FileLoadStats {
+    int64_t bytes = 0;          ///< Number of bytes loaded.
+    uint32_t chunks = 0;        ///< Number of chunks copied.
+    uint32_t windows = 0;       ///< Number of file windows mapped.
+    uint32_t stalls = 0;        ///< Number of times a chunk had to wait for the GPU to finish copying it.
+    double seconds = 0.0;       ///< Wall clock time of the load including the final wait for the GPU.
+
+    /**
+     * @brief Gets the throughput in GB/s.
+     */
+    double gigabytesPerSecond() const { return seconds > 0.0 ? (double)bytes / seconds / 1e9 : 0.0; }
+};
+
+/**
+ * @brief Read only memory mapping of a sliding window of a file.
+ *
+ * Only the window passed to map() is mapped at a time, so large files never occupy more address space
+ * or resident memory than the window. The window is advised for sequential access where supported.
+ *
+ * @warning This class is not guaranteed to be thread-safe.
+ */
+class FileMapping {
+protected:
+    intptr_t _file = -1;        // file HANDLE on Windows, file descriptor on POSIX
+    intptr_t _mapping = 0;      // file mapping HANDLE on Windows, unused on POSIX
+    int64_t _size = 0;
+    void* _view = nullptr;      // start of the mapped view, aligned down to the allocation granularity
+    int64_t _viewSize = 0;
+    int64_t _offset = 0;        // file offset of the requested window
+    int64_t _length = 0;
+
+    void _close();
+
+public:
+    /**
+     * @brief Construct an empty FileMapping.
+     */
+    FileMapping() = default;
+
+    /**
+     * @brief Opens a file for mapping.
+     *
+     * @throws std::runtime_error If the file could not be opened
+     *
+     * @param path The path of the file
+     */
+    FileMapping(const std::string& path);
+    FileMapping(FileMapping&& other);
+    FileMapping(const FileMapping& other) = delete;
+    ~FileMapping() noexcept;
+
+    /**
+     * @brief Maps a window of the file, replacing the previous one.
+     *
+     * @throws std::logic_error If no file is open
+     * @throws std::runtime_error If offset is negativ or length is not greater than 0
+     * @throws std::runtime_error If offset + length is greater than the size of the file
+     * @throws std::runtime_error If mapping failed
+     *
+     * @param offset The offset of the window into the file in bytes
+     * @param length The length of the window in bytes
+     *
+     * @returns A pointer to the byte at offset, valid until the next call to map() or unmap()
+     */
+    const char* map(int64_t offset, int64_t length);
+
+    /**
+     * @brief Unmaps the current window.
+     */
+    void unmap();
+
+    bool valid() const { return _file != -1; }          ///< Checks if a file is open.
+    int64_t size() const { return _size; }              ///< Gets the size of the file in bytes.
+    int64_t windowOffset() const { return _offset; }    ///< Gets the file offset of the mapped window.
+    int64_t windowLength() const { return _length; }    ///< Gets the length of the mapped window, 0 if nothing is mapped.
+
+    /**
+     * @brief Gets the granularity window offsets are aligned to internally.
+     */
+    static int64_t granularity();
+
+    FileMapping& operator=(FileMapping&& other);
+    FileMapping& operator=(const FileMapping& other) = delete;
+};
+
+}
+
+#endif
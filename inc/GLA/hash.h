@@ -0,0 +1,38 @@
+#ifndef GLA_HASH_H
+#define GLA_HASH_H
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+
+namespace gla {
+
+/**
+ * @brief 128 bit hash value.
+ */
+struct Hash128 {
+    uint64_t low = 0;
+    uint64_t high = 0;
+
+    auto operator<=>(const Hash128& other) const = default;
+};
+
+/**
+ * @brief Hashes a block of memory with a fast non-cryptographic 128 bit hash.
+ *
+ * Consumes 32 byte stripes in four independent 64 bit lanes (xxHash64 rounds), so the main loop runs at memory speed
+ * and is vectorized by the compiler. The second half of the result comes from the lane states and a second pass over
+ * the tail with other constants, so both halves depend on the input independently, also for inputs below 32 bytes.
+ * Meant for content deduplication, not for security.
+ *
+ * @param data The memory to hash (must have at least size bytes)
+ * @param size The size of the memory in bytes
+ * @param seed Seed to derive independent hash functions
+ *
+ * @returns The hash of the memory
+ */
+Hash128 hash128(const void* data, size_t size, uint64_t seed = 0);
+
+}
+
+#endif
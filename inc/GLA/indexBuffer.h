@@ -0,0 +1,180 @@
+#ifndef GLA_INDEX_BUFFER_H
+#define GLA_INDEX_BUFFER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include <GLA/buffer.h>
+
+namespace gla {
+
+/**
+ * @brief Enum to indicate the width of the indices of an IndexBuffer.
+ */
+enum class IndexType {
+    UnsignedShort,  ///< 16 bit indices, used when every index is below 0xFFFF
+    UnsignedInt     ///< 32 bit indices
+};
+
+/**
+ * @brief Enum to indicate how indexed vertices are assembled into primitives.
+ */
+enum class PrimitiveMode {
+    Points,
+    Lines,
+    LineStrip,
+    LineLoop,
+    Triangles,
+    TriangleStrip,
+    TriangleFan
+};
+
+/**
+ * @brief Converts an IndexType to the corresponding GLenum.
+ */
+unsigned int toGLenum(IndexType type);
+
+/**
+ * @brief Converts a PrimitiveMode to the corresponding GLenum.
+ */
+unsigned int toGLenum(PrimitiveMode mode);
+
+/**
+ * @brief Size of one index of the given IndexType in bytes.
+ */
+constexpr int indexBytes(IndexType type) {
+    return type == IndexType::UnsignedShort ? 2 : 4;
+}
+
+/**
+ * @brief IndexBuffer class owning a BufferType::ElementArray Buffer and issuing indexed draws.
+ *
+ * Indices are always given as 32 bit values. On upload, the narrowest IndexType that holds the largest index
+ * is chosen, so meshes with fewer than 65535 vertices only need half the memory and index fetch bandwidth.
+ * IndexBuffer::RESTART marks the end of a strip or fan, it is translated to the restart index of the chosen width.
+ *
+ * @code
+ * gla::IndexBuffer ibo;
+ * ibo.setIndices(indices);
+ * vao.setElementBuffer(ibo.buffer());
+ * vao.bind();
+ * ibo.draw(gla::PrimitiveMode::Triangles);
+ * @endcode
+ *
+ * @warning IndexBuffer must be deconstructed before the OpenGL context is destroyed.
+ * @warning This class is not guaranteed to be thread-safe.
+ */
+class IndexBuffer {
+protected:
+    Buffer _buffer;
+    IndexType _type = IndexType::UnsignedShort;
+    int64_t _count = 0;
+    uint32_t _maxIndex = 0;
+    bool _restart = false;
+
+    void _draw(PrimitiveMode mode, int64_t first, int64_t count, int instances) const;
+
+public:
+    static constexpr uint32_t RESTART = 0xFFFFFFFF; ///< Index value that restarts the primitive.
+
+    /**
+     * @brief Construct a new IndexBuffer without any indices.
+     *
+     * @throws std::runtime_error If the buffer object could not be created
+     */
+    IndexBuffer();
+    IndexBuffer(IndexBuffer&& other) = default;
+    IndexBuffer(const IndexBuffer& other) = delete;
+
+    /**
+     * @brief Uploads indices, choosing IndexType::UnsignedShort if every index (except RESTART) is below 0xFFFF.
+     *
+     * Without Capabilities::directStateAccess, VAO 0 is bound during the upload and the previous VAO is restored
+     * afterwards, so the element Buffer recorded in the bound VertexArrayObject is never replaced.
+     *
+     * @throws std::runtime_error If the Buffer storage could not be set, see Buffer::setData
+     *
+     * @param indices The indices, RESTART restarts the primitive
+     * @param usage The usage hint of the Buffer
+     */
+    void setIndices(std::span<const uint32_t> indices, BufferUsage usage = BufferUsage::StaticDraw);
+
+    /**
+     * @brief Draws all indices with the vertex state of the currently bound VertexArrayObject.
+     *
+     * Primitive restart is enabled for the draw if the indices contain RESTART.
+     *
+     * @warning The bound VertexArrayObject must use buffer() as its element Buffer.
+     *
+     * @param mode How the vertices are assembled into primitives
+     * @param instances The number of instances to draw
+     */
+    void draw(PrimitiveMode mode, int instances = 1) const { _draw(mode, 0, _count, instances); }
+
+    /**
+     * @brief Draws a range of the indices, see draw(PrimitiveMode, int).
+     *
+     * @throws std::out_of_range If the range is not within the indices
+     *
+     * @param mode How the vertices are assembled into primitives
+     * @param first The first index to draw
+     * @param count The number of indices to draw
+     * @param instances The number of instances to draw
+     */
+    void draw(PrimitiveMode mode, int64_t first, int64_t count, int instances = 1) const;
+
+    const Buffer& buffer() const { return _buffer; }    ///< The element Buffer, to record with VertexArrayObject::setElementBuffer.
+    IndexType type() const { return _type; }            ///< The width chosen by the last setIndices.
+    int64_t count() const { return _count; }            ///< The number of indices, including restarts.
+    uint32_t maxIndex() const { return _maxIndex; }     ///< The largest index except RESTART.
+    bool restart() const { return _restart; }           ///< If the indices contain RESTART.
+
+    IndexBuffer& operator=(IndexBuffer&& other) = default;
+    IndexBuffer& operator=(const IndexBuffer& other) = delete;
+};
+
+/**
+ * @brief Merges bitwise identical vertices and builds the indices referencing the remaining ones.
+ *
+ * Every vertex is hashed with gla::hash128 and looked up in an open addressing table, so welding runs in linear time.
+ * The unique vertices are moved to the front in order of their first occurrence, which keeps the memory locality
+ * of the input. Meshes stored as triangle soups typically shrink to a sixth of their vertices and the
+ * post-transform vertex cache can reuse shared vertices.
+ *
+ * @throws std::invalid_argument If stride is not greater than 0
+ * @throws std::length_error If count does not fit into 32 bit indices
+ *
+ * @warning Vertices are compared bitwise: padding bytes must be initialized and 0.0f and -0.0f are different.
+ *
+ * @param vertices The vertices, compacted in place (must have count * stride bytes)
+ * @param count The number of vertices
+ * @param stride The size of one vertex in bytes
+ * @param indices Receives one index per input vertex
+ *
+ * @returns The number of unique vertices at the front of vertices
+ */
+size_t weldVertices(void* vertices, size_t count, int stride, std::vector<uint32_t>& indices);
+
+/**
+ * @brief Merges bitwise identical vertices of a vector and shrinks it, see weldVertices(void*, size_t, int, std::vector<uint32_t>&).
+ *
+ * @param vertices The vertices, compacted in place
+ *
+ * @returns One index per input vertex
+ */
+template <typename Vertex>
+std::vector<uint32_t> weldVertices(std::vector<Vertex>& vertices) {
+    static_assert(std::is_trivially_copyable_v<Vertex>, "Vertices must be trivially copyable!");
+    std::vector<uint32_t> indices;
+    size_t unique = weldVertices(vertices.data(), vertices.size(), static_cast<int>(sizeof(Vertex)), indices);
+    vertices.erase(vertices.begin() + static_cast<std::ptrdiff_t>(unique), vertices.end());
+    return indices;
+}
+
+}
+
+#endif
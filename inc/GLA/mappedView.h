@@ -0,0 +1,226 @@
+#ifndef GLA_MAPPED_VIEW_H
+#define GLA_MAPPED_VIEW_H
+
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include <GLA/buffer.h>
+
+namespace gla {
+
+/**
+ * @brief Typed span over a mapped range of a Buffer that records written ranges and flushes them coalesced.
+ *
+ * With MapUsage::FlushExplicit only the ranges passed to markDirty / write are flushed. flush() sorts them and merges
+ * overlapping and adjacent ranges, so sparse updates cost as few glFlushMappedBufferRange calls as possible.
+ * Without MapUsage::FlushExplicit the dirty ranges are not recorded and flush() does nothing.
+ *
+ * A view either maps the Buffer itself and unmaps it on destruction, or views a mapping that already exists,
+ * for example a persistent one, and leaves it mapped.
+ *
+ * @warning The Buffer must outlive the MappedView.
+ * @warning This class is not guaranteed to be thread-safe.
+ *
+ * @note Writes through operator[], data() or the iterators are not tracked, call markDirty for them.
+ */
+template <typename T>
+class MappedView {
+    static_assert(std::is_trivially_copyable_v<T>, "Buffer data must be trivially copyable!");
+
+protected:
+    struct _Range {
+        int64_t begin; // in bytes relative to the start of the mapping
+        int64_t end;
+    };
+
+    static constexpr size_t _COALESCE_THRESHOLD = 1024; // merge early to bound the memory of many tiny writes
+
+    Buffer* _buffer = nullptr;
+    T* _data = nullptr;
+    int64_t _count = 0;
+    bool _owning = false;
+    bool _flushExplicit = false;
+    std::vector<_Range> _dirty = {};
+    size_t _nextCoalesce = _COALESCE_THRESHOLD;
+
+    void _coalesce() {
+        if (_dirty.size() < 2)
+            return;
+        std::sort(_dirty.begin(), _dirty.end(), [](const _Range& a, const _Range& b) { return a.begin < b.begin; });
+        size_t last = 0;
+        for (size_t i = 1; i < _dirty.size(); i++) {
+            if (_dirty[i].begin <= _dirty[last].end)
+                _dirty[last].end = std::max(_dirty[last].end, _dirty[i].end);
+            else
+                _dirty[++last] = _dirty[i];
+        }
+        _dirty.resize(last + 1);
+        // many disjoint ranges survive merging, wait for the vector to double so merging stays amortized O(log n) per range
+        _nextCoalesce = std::max(_COALESCE_THRESHOLD, 2 * _dirty.size());
+    }
+
+    void _release() {
+        if (_buffer == nullptr)
+            return;
+        flush();
+        if (_owning)
+            _buffer->unmap();
+        _buffer = nullptr;
+        _data = nullptr;
+        _count = 0;
+    }
+
+public:
+    /**
+     * @brief Construct an empty view.
+     */
+    MappedView() = default;
+
+    /**
+     * @brief Maps count elements of type T starting at element first and views them.
+     *
+     * @throws std::runtime_error If count is not greater than 0 or the range is outside of the Buffer
+     * @throws std::runtime_error If mapping failed, see Buffer::map
+     *
+     * @param buffer The Buffer to map, unmapped again when the view is destroyed
+     * @param first The index of the first element
+     * @param count The number of elements
+     * @param access The usage of the mapped range
+     */
+    MappedView(Buffer& buffer, int64_t first, int64_t count, MapUsage access)
+        : _buffer(&buffer), _count(count), _owning(true), _flushExplicit((access & MapUsage::FlushExplicit) != MapUsage::None) {
+        _data = static_cast<T*>(buffer.map(first * static_cast<int64_t>(sizeof(T)), count * static_cast<int64_t>(sizeof(T)), access));
+    }
+
+    /**
+     * @brief Views the existing mapping of the Buffer without taking ownership of it.
+     *
+     * @throws std::logic_error If the Buffer is not mapped
+     *
+     * @param buffer The mapped Buffer, left mapped when the view is destroyed
+     */
+    explicit MappedView(Buffer& buffer)
+        : _buffer(&buffer), _data(static_cast<T*>(buffer.mapPointer())), _count(buffer.mapLength() / static_cast<int64_t>(sizeof(T))),
+          _flushExplicit((buffer.getMapUsage() & MapUsage::FlushExplicit) != MapUsage::None) {
+        if (!buffer.mapped())
+            throw std::logic_error("Buffer is not mapped!");
+    }
+
+    MappedView(MappedView&& other)
+        : _buffer(other._buffer), _data(other._data), _count(other._count), _owning(other._owning), _flushExplicit(other._flushExplicit), _dirty(std::move(other._dirty)), _nextCoalesce(other._nextCoalesce) {
+        other._buffer = nullptr;
+        other._data = nullptr;
+        other._count = 0;
+        other._dirty.clear();
+    }
+    MappedView(const MappedView& other) = delete;
+
+    ~MappedView() noexcept {
+        try {
+            _release();
+        } catch (...) {}
+    }
+
+    bool valid() const { return _buffer != nullptr; }                       ///< Checks if the view refers to a mapping.
+    int64_t size() const { return _count; }                                 ///< Gets the number of elements.
+    T* data() const { return _data; }                                       ///< Gets a pointer to the first element.
+    T* begin() const { return _data; }                                      ///< Gets an iterator to the first element.
+    T* end() const { return _data + _count; }                               ///< Gets an iterator past the last element.
+    std::span<T> span() const { return { _data, static_cast<size_t>(_count) }; } ///< Gets a span over all elements.
+    T& operator[](int64_t index) const { return _data[index]; }             ///< Accesses an element without marking it dirty.
+
+    /**
+     * @brief Records that elements have been written and must be flushed.
+     *
+     * @throws std::out_of_range If the range is outside of the view
+     *
+     * @param first The index of the first written element
+     * @param count The number of written elements
+     */
+    void markDirty(int64_t first, int64_t count = 1) {
+        if (first < 0 || count < 0 || first + count > _count)
+            throw std::out_of_range("Range is outside of the MappedView!");
+        if (!_flushExplicit || count == 0)
+            return;
+        int64_t begin = first * static_cast<int64_t>(sizeof(T));
+        _dirty.push_back({ begin, begin + count * static_cast<int64_t>(sizeof(T)) });
+        if (_dirty.size() >= _nextCoalesce)
+            _coalesce();
+    }
+
+    /**
+     * @brief Writes an element and marks it dirty.
+     *
+     * @throws std::out_of_range If index is outside of the view
+     */
+    void write(int64_t index, const T& value) {
+        markDirty(index, 1);
+        _data[index] = value;
+    }
+
+    /**
+     * @brief Writes consecutive elements and marks them dirty.
+     *
+     * @throws std::out_of_range If the range is outside of the view
+     */
+    void write(int64_t first, std::span<const T> values) {
+        markDirty(first, static_cast<int64_t>(values.size()));
+        std::copy(values.begin(), values.end(), _data + first);
+    }
+
+    /**
+     * @brief Gets the number of dirty ranges waiting for the next flush.
+     */
+    size_t dirtyRanges() const { return _dirty.size(); }
+
+    /**
+     * @brief Flushes all dirty ranges with as few calls as possible.
+     *
+     * @returns The number of glFlushMappedBufferRange calls issued
+     */
+    size_t flush() {
+        if (_dirty.empty())
+            return 0;
+        _coalesce();
+        for (const _Range& range : _dirty)
+            _buffer->flushMappedRange(range.begin, range.end - range.begin);
+        size_t calls = _dirty.size();
+        _dirty.clear();
+        _nextCoalesce = _COALESCE_THRESHOLD;
+        return calls;
+    }
+
+    /**
+     * @brief Flushes and, if the view mapped the Buffer itself, unmaps it. The view is empty afterwards.
+     *
+     * @throws std::runtime_error If OpenGL signalled data corruption while unmapping
+     */
+    void unmap() { _release(); }
+
+    MappedView& operator=(MappedView&& other) {
+        if (this != &other) {
+            _release();
+            _buffer = other._buffer;
+            _data = other._data;
+            _count = other._count;
+            _owning = other._owning;
+            _flushExplicit = other._flushExplicit;
+            _dirty = std::move(other._dirty);
+            _nextCoalesce = other._nextCoalesce;
+            other._buffer = nullptr;
+            other._data = nullptr;
+            other._count = 0;
+            other._dirty.clear();
+        }
+        return *this;
+    }
+    MappedView& operator=(const MappedView& other) = delete;
+};
+
+}
+
+#endif
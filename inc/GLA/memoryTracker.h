@@ -0,0 +1,155 @@
+#ifndef GLA_MEMORY_TRACKER_H
+#define GLA_MEMORY_TRACKER_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#include <GLA/buffer.h>
+
+namespace gla {
+
+/**
+ * @brief Enum to indicate the kind of OpenGL object counted by the MemoryTracker.
+ */
+enum class TrackedObject {
+    Buffer,
+    Shader,
+    Program,
+    VertexArray
+};
+
+/**
+ * @brief Enum to group Buffer storage by how it may be accessed.
+ */
+enum class BufferStorageClass {
+    Mutable,    ///< Storage allocated with Buffer::setData, see BufferUsage for the split by usage.
+    Static,     ///< Immutable storage without BufferFlag::DynamicStorage or map flags.
+    Dynamic,    ///< Immutable storage with BufferFlag::DynamicStorage only.
+    Mapped,     ///< Immutable storage with BufferFlag::MapRead or BufferFlag::MapWrite.
+    Persistent, ///< Immutable storage with BufferFlag::MapPersistent.
+    Sparse      ///< Immutable storage with BufferFlag::Sparse, accounted with its full virtual size.
+};
+
+constexpr size_t TRACKED_OBJECT_COUNT = static_cast<size_t>(TrackedObject::VertexArray) + 1;
+constexpr size_t BUFFER_TYPE_COUNT = static_cast<size_t>(BufferType::Uniform) + 1;
+constexpr size_t BUFFER_USAGE_COUNT = static_cast<size_t>(BufferUsage::DynamicCopy) + 1;
+constexpr size_t BUFFER_STORAGE_CLASS_COUNT = static_cast<size_t>(BufferStorageClass::Sparse) + 1;
+
+/**
+ * @brief Gets the BufferStorageClass of a Buffer data store.
+ *
+ * @param immutable If the storage was allocated with Buffer::setStorage
+ * @param flags The BufferFlag of immutable storage
+ */
+BufferStorageClass storageClass(bool immutable, BufferFlag flags);
+
+/**
+ * @brief Copy of the counters of the MemoryTracker at one point in time.
+ */
+struct MemorySnapshot {
+    int64_t bufferBytes = 0;                    ///< Bytes of all live Buffer data stores.
+    int64_t highWaterBytes = 0;                 ///< Highest value of bufferBytes since the start of the process.
+    int64_t frameHighWaterBytes = 0;            ///< Highest value of bufferBytes during the last finished frame.
+    uint64_t frames = 0;                        ///< Number of frames finished with MemoryTracker::endFrame.
+
+    std::array<int64_t, BUFFER_TYPE_COUNT> bytesByType = {};                    ///< Bytes indexed by BufferType.
+    std::array<int64_t, BUFFER_USAGE_COUNT> bytesByUsage = {};                  ///< Bytes of mutable storage indexed by BufferUsage.
+    std::array<int64_t, BUFFER_STORAGE_CLASS_COUNT> bytesByStorageClass = {};   ///< Bytes indexed by BufferStorageClass.
+    std::array<int64_t, TRACKED_OBJECT_COUNT> liveObjects = {};                 ///< Live objects indexed by TrackedObject.
+
+    int64_t driverTotalKB = -1;     ///< Dedicated video memory reported by GL_NVX_gpu_memory_info in KB, -1 if unknown.
+    int64_t driverAvailableKB = -1; ///< Free video memory reported by GL_NVX_gpu_memory_info or GL_ATI_meminfo in KB, -1 if unknown.
+
+    /**
+     * @brief Gets the number of live objects of a kind.
+     */
+    int64_t live(TrackedObject object) const { return liveObjects[static_cast<size_t>(object)]; }
+};
+
+/**
+ * @brief Accounts the memory and objects owned by the abstraction.
+ *
+ * Buffer, Shader, Program and VertexArrayObject report their creation, allocation and destruction to the tracker returned by
+ * memoryTracker(), so the counters are always on. Every update is a few relaxed atomic additions.
+ * gla::WindowContext calls endFrame() in WindowContext::swapBuffers of a single context and prints leakReport() when the last
+ * WindowContext is destroyed, since the counters cover the objects of all contexts.
+ *
+ * @note All methods are thread-safe, except snapshot(true) which has to be called on the thread the OpenGL context is current on.
+ * @note Objects still queued in the gla::DeletionQueue are no longer counted as live.
+ */
+class MemoryTracker {
+protected:
+    std::atomic<int64_t> _bufferBytes = 0;
+    std::atomic<int64_t> _highWater = 0;
+    std::atomic<int64_t> _frameHighWater = 0;
+    std::atomic<int64_t> _lastFrameHighWater = 0;
+    std::atomic<uint64_t> _frames = 0;
+    std::array<std::atomic<int64_t>, BUFFER_TYPE_COUNT> _byType = {};
+    std::array<std::atomic<int64_t>, BUFFER_USAGE_COUNT> _byUsage = {};
+    std::array<std::atomic<int64_t>, BUFFER_STORAGE_CLASS_COUNT> _byStorageClass = {};
+    std::array<std::atomic<int64_t>, TRACKED_OBJECT_COUNT> _live = {};
+
+    void _account(BufferType type, bool immutable, BufferUsage usage, BufferFlag flags, int64_t bytes);
+
+public:
+    MemoryTracker() = default;
+    MemoryTracker(const MemoryTracker& other) = delete;
+    MemoryTracker(MemoryTracker&& other) = delete;
+
+    /**
+     * @brief Counts a newly created OpenGL object.
+     */
+    void objectCreated(TrackedObject object);
+
+    /**
+     * @brief Counts a destroyed OpenGL object.
+     */
+    void objectDestroyed(TrackedObject object);
+
+    /**
+     * @brief Accounts a newly allocated Buffer data store.
+     *
+     * @param type The BufferType of the Buffer
+     * @param immutable If the storage was allocated with Buffer::setStorage
+     * @param usage The BufferUsage of mutable storage
+     * @param flags The BufferFlag of immutable storage
+     * @param size The size of the data store in bytes
+     */
+    void bufferAllocated(BufferType type, bool immutable, BufferUsage usage, BufferFlag flags, int64_t size);
+
+    /**
+     * @brief Removes a released Buffer data store, the arguments must match the ones of bufferAllocated.
+     */
+    void bufferReleased(BufferType type, bool immutable, BufferUsage usage, BufferFlag flags, int64_t size);
+
+    /**
+     * @brief Finishes the frame high-water mark and starts the next one at the current number of bytes.
+     */
+    void endFrame();
+
+    /**
+     * @brief Copies the counters.
+     *
+     * @param queryDriver Also query the free memory reported by GL_NVX_gpu_memory_info or GL_ATI_meminfo
+     *                    (requires a current OpenGL context)
+     */
+    MemorySnapshot snapshot(bool queryDriver = false) const;
+
+    /**
+     * @brief Lists the objects and bytes that are still alive.
+     *
+     * @returns An empty string if nothing is alive, otherwise a human readable report
+     */
+    std::string leakReport() const;
+};
+
+/**
+ * @brief Gets the process wide MemoryTracker updated by the abstraction.
+ */
+MemoryTracker& memoryTracker();
+
+}
+
+#endif
@@ -0,0 +1,145 @@
+#ifndef GLA_MESH_OPTIMIZER_H
+#define GLA_MESH_OPTIMIZER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace gla {
+
+/**
+ * @brief Post-transform vertex cache efficiency of a triangle list, see gla::analyzeVertexCache.
+ */
+struct VertexCacheStats {
+    size_t triangles = 0;   ///< Number of triangles.
+    size_t vertices = 0;    ///< Number of distinct vertices referenced by the triangles.
+    size_t transforms = 0;  ///< Number of vertex shader invocations (cache misses).
+    float acmr = 0.0f;      ///< Average cache miss ratio, transforms per triangle (0.5 at best for large meshes, 3 at worst).
+    float atvr = 0.0f;      ///< Average transform to vertex ratio, transforms per vertex (1 at best).
+};
+
+/**
+ * @brief Options of gla::optimizeMesh.
+ */
+struct MeshOptimizeOptions {
+    unsigned int cacheSize = 16;    ///< FIFO size used to measure the result, the reordering itself does not depend on it.
+    bool overdraw = false;          ///< If clusters of triangles are sorted to reduce overdraw, needs positionOffset.
+    int positionOffset = 0;         ///< Offset of the position (3 floats) in a vertex in bytes.
+    float overdrawThreshold = 1.05f; ///< How much worse the ACMR may get for overdraw, see gla::optimizeOverdraw.
+};
+
+/**
+ * @brief Effect of gla::optimizeMesh.
+ */
+struct MeshOptimizeReport {
+    VertexCacheStats before;    ///< Cache efficiency of the input.
+    VertexCacheStats after;     ///< Cache efficiency of the output.
+    size_t vertices = 0;        ///< Number of vertices left, unreferenced vertices are removed.
+};
+
+/**
+ * @brief Simulates a FIFO post-transform vertex cache to measure how many vertex shader invocations a triangle list needs.
+ *
+ * @throws std::invalid_argument If the number of indices is not a multiple of 3
+ * @throws std::invalid_argument If cacheSize is 0
+ * @throws std::out_of_range If an index is not below vertexCount
+ *
+ * @param indices The triangle list
+ * @param vertexCount The number of vertices
+ * @param cacheSize The number of entries of the simulated cache
+ *
+ * @returns The ACMR and ATVR of the triangle list
+ */
+VertexCacheStats analyzeVertexCache(std::span<const uint32_t> indices, size_t vertexCount, unsigned int cacheSize = 16);
+
+/**
+ * @brief Reorders triangles for post-transform vertex cache locality with Tom Forsyth's linear-speed algorithm.
+ *
+ * Triangles are emitted greedily by a score that prefers vertices recently used and vertices with few remaining
+ * triangles, so the result performs well on any cache size and replacement policy.
+ *
+ * @throws std::invalid_argument If the number of indices is not a multiple of 3
+ * @throws std::out_of_range If an index is not below vertexCount
+ *
+ * @param indices The triangle list, reordered in place
+ * @param vertexCount The number of vertices
+ */
+void optimizeVertexCache(std::span<uint32_t> indices, size_t vertexCount);
+
+/**
+ * @brief Reorders clusters of triangles so outward facing geometry is drawn first, reducing overdraw.
+ *
+ * The triangle list is split where all vertices of a triangle miss the cache and where the ACMR of the cluster so far,
+ * starting with a cold cache, is at most threshold times the ACMR of the whole list. Clusters are then sorted by how far
+ * they face away from the mesh center. Call it after optimizeVertexCache, the order inside each cluster is kept.
+ *
+ * @throws std::invalid_argument If the number of indices is not a multiple of 3
+ * @throws std::invalid_argument If the position extends over the stride
+ * @throws std::out_of_range If an index is not below vertexCount
+ *
+ * @param indices The triangle list, reordered in place
+ * @param vertices The vertices
+ * @param vertexCount The number of vertices
+ * @param stride The size of one vertex in bytes
+ * @param positionOffset The offset of the position (3 floats) in a vertex in bytes
+ * @param threshold Values above 1 allow more splits, trading vertex cache efficiency for less overdraw
+ * @param cacheSize The number of entries of the simulated cache
+ */
+void optimizeOverdraw(std::span<uint32_t> indices, const void* vertices, size_t vertexCount, int stride, int positionOffset, float threshold = 1.05f, unsigned int cacheSize = 16);
+
+/**
+ * @brief Reorders vertices in the order of their first use, so vertex fetch reads memory sequentially.
+ *
+ * @throws std::invalid_argument If stride is not greater than 0
+ * @throws std::out_of_range If an index is not below vertexCount
+ *
+ * @param indices The indices, remapped in place
+ * @param vertices The vertices, reordered in place (must have vertexCount * stride bytes)
+ * @param vertexCount The number of vertices
+ * @param stride The size of one vertex in bytes
+ *
+ * @returns The number of referenced vertices, unreferenced vertices are dropped from the end
+ */
+size_t optimizeVertexFetch(std::span<uint32_t> indices, void* vertices, size_t vertexCount, int stride);
+
+/**
+ * @brief Runs optimizeVertexCache, optionally optimizeOverdraw, and optimizeVertexFetch on a triangle list.
+ *
+ * Meant to run offline or at load time, before the data is uploaded with Buffer::setData.
+ *
+ * @throws std::invalid_argument If the mesh or the options are invalid, see the individual steps
+ *
+ * @param indices The triangle list, optimized in place
+ * @param vertices The vertices, reordered in place (must have vertexCount * stride bytes)
+ * @param vertexCount The number of vertices
+ * @param stride The size of one vertex in bytes
+ * @param options The steps to run
+ *
+ * @returns The ACMR and ATVR before and after
+ */
+MeshOptimizeReport optimizeMesh(std::span<uint32_t> indices, void* vertices, size_t vertexCount, int stride, const MeshOptimizeOptions& options = {});
+
+/**
+ * @brief Optimizes a mesh held in vectors and shrinks the vertices, see optimizeMesh(std::span<uint32_t>, void*, size_t, int, const MeshOptimizeOptions&).
+ *
+ * @code
+ * gla::MeshOptimizeOptions options;
+ * options.overdraw = true;
+ * options.positionOffset = offsetof(Vertex, pos);
+ * gla::MeshOptimizeReport report = gla::optimizeMesh(vertices, indices, options);
+ * @endcode
+ */
+template <typename Vertex>
+MeshOptimizeReport optimizeMesh(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices, const MeshOptimizeOptions& options = {}) {
+    static_assert(std::is_trivially_copyable_v<Vertex>, "Vertices must be trivially copyable!");
+    MeshOptimizeReport report = optimizeMesh(indices, vertices.data(), vertices.size(), static_cast<int>(sizeof(Vertex)), options);
+    vertices.erase(vertices.begin() + static_cast<std::ptrdiff_t>(report.vertices), vertices.end());
+    return report;
+}
+
+}
+
+#endif
@@ -0,0 +1,121 @@
+#ifndef GLA_OFFSET_ALLOCATOR_H
+#define GLA_OFFSET_ALLOCATOR_H
+
+#include <cstdint>
+#include <vector>
+#include <stdexcept>
+
+namespace gla {
+
+/**
+ * @brief A range handed out by OffsetAllocator::allocate.
+ */
+struct OffsetAllocation {
+    static constexpr uint32_t InvalidNode = 0xFFFFFFFF;
+
+    int64_t offset = 0;             ///< Offset of the range in bytes.
+    int64_t size = 0;               ///< Size of the range in bytes (rounded up to the granularity).
+    uint32_t node = InvalidNode;    ///< Internal handle, InvalidNode if the allocation failed.
+
+    /**
+     * @brief Checks if the allocation succeeded.
+     */
+    bool valid() const { return node != InvalidNode; }
+};
+
+/**
+ * @brief Two-level segregated fit (TLSF) allocator for offsets into a linear range.
+ *
+ * Manages offsets only and never touches any memory, so it can be used to sub-allocate GPU Buffers.
+ * Allocating and freeing are O(1): free ranges are kept in size class bins found through two bitmaps
+ * and neighbouring free ranges are merged immediately.
+ *
+ * @warning This class is not guaranteed to be thread-safe.
+ */
+class OffsetAllocator {
+protected:
+    static constexpr uint32_t _SL_LOG2 = 4;
+    static constexpr uint32_t _SL_COUNT = 1 << _SL_LOG2;
+    static constexpr uint32_t _FL_COUNT = 64;
+
+    struct _Node {
+        int64_t offset;     // in units of the granularity
+        int64_t size;       // in units of the granularity
+        uint32_t prevPhys;
+        uint32_t nextPhys;
+        uint32_t prevFree;
+        uint32_t nextFree;
+        bool used;
+    };
+
+    int64_t _granularity;
+    int64_t _units;
+    int64_t _usedUnits = 0;
+    uint32_t _freeRegions = 0;
+    uint32_t _allocations = 0;
+
+    std::vector<_Node> _nodes = {};
+    std::vector<uint32_t> _unusedNodes = {};
+
+    uint64_t _flBitmap = 0;
+    uint32_t _slBitmap[_FL_COUNT] = {};
+    uint32_t _bins[_FL_COUNT * _SL_COUNT];
+
+    static void _mapping(int64_t units, uint32_t& fl, uint32_t& sl);
+    uint32_t _newNode();
+    void _insertFree(uint32_t node);
+    void _removeFree(uint32_t node);
+    uint32_t _findFree(int64_t units) const;
+
+public:
+    OffsetAllocator() = delete;
+    /**
+     * @brief Construct a new OffsetAllocator managing the range [0; size).
+     *
+     * @throws std::invalid_argument If granularity is not greater than 0
+     * @throws std::invalid_argument If size is not greater than or equal to granularity
+     *
+     * @param size The size of the managed range in bytes (rounded down to the granularity)
+     * @param granularity All offsets and sizes are multiples of this value, used for alignment
+     */
+    OffsetAllocator(int64_t size, int64_t granularity = 1);
+
+    /**
+     * @brief Allocates a range of at least size bytes.
+     *
+     * @throws std::invalid_argument If size is not greater than 0
+     *
+     * @returns The allocated range, check OffsetAllocation::valid as the allocation fails if no free range is big enough
+     */
+    OffsetAllocation allocate(int64_t size);
+
+    /**
+     * @brief Returns a range to the allocator.
+     *
+     * @throws std::invalid_argument If the allocation is invalid or was already freed
+     */
+    void free(const OffsetAllocation& allocation);
+
+    /**
+     * @brief Frees all allocations at once.
+     */
+    void reset();
+
+    int64_t size() const { return _units * _granularity; }                      ///< Size of the managed range in bytes.
+    int64_t granularity() const { return _granularity; }                        ///< Granularity of offsets and sizes in bytes.
+    int64_t usedBytes() const { return _usedUnits * _granularity; }             ///< Number of bytes currently allocated.
+    int64_t freeBytes() const { return (_units - _usedUnits) * _granularity; }  ///< Number of bytes currently free.
+    uint32_t freeRegions() const { return _freeRegions; }                       ///< Number of separate free ranges.
+    uint32_t allocations() const { return _allocations; }                       ///< Number of live allocations.
+
+    /**
+     * @brief Gets the size of the largest free range in bytes.
+     *
+     * @note Walks the highest non empty size class, so it is not O(1).
+     */
+    int64_t largestFreeRegion() const;
+};
+
+}
+
+#endif
@@ -11,6 +11,7 @@
 
 namespace gla {
 
+class DeletionQueue;
 class Shader;
 
 /**
@@ -56,19 +57,20 @@ struct UniformData {
  * @warning This class is not guaranteed to be thread-safe.
  * 
  * @note This class owns the underlying OpenGL Program object and
- *       releases it upon destruction or reset().
+ *       releases it upon destruction or reset() through the gla::DeletionQueue of the context it was created in.
  */
 class Program {
 protected:
     unsigned int _id = 0;
     bool _linked = false;
+    DeletionQueue* _deletionQueue = nullptr; // of the context the program object was created in
 
     std::unordered_map<std::string, int> _uniformIndexMap = {}; // name to uniform index conversion
     std::unordered_map<int, int> _uniformLocationIndexMap = {}; // location to uniform index conversion
     std::vector<UniformData> _uniformData = {}; // uniform data per index
 
     void _delete();
-    void _check() const;
+    void _check();
     void _ensure() const;
     void _queryUniformData();
     void _setupUniform(int loc, int sizeCheck, int typeCheck) const;
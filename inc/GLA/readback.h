@@ -0,0 +1,172 @@
+#ifndef GLA_READBACK_H
+#define GLA_READBACK_H
+
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <vector>
+#include <stdexcept>
+
+#include <GLA/buffer.h>
+#include <GLA/fence.h>
+
+namespace gla {
+
+/**
+ * @brief Handle to the result of Buffer::readAsync, resolved by ReadbackQueue::poll.
+ *
+ * Handles are cheap to copy, all copies refer to the same result.
+ */
+class Readback {
+protected:
+    struct _State {
+        std::vector<char> data;
+        bool ready = false;
+    };
+
+    std::shared_ptr<_State> _state = nullptr;
+
+    friend class ReadbackQueue;
+
+public:
+    /**
+     * @brief Checks if the handle refers to a readback.
+     */
+    bool valid() const { return _state != nullptr; }
+
+    /**
+     * @brief Checks if the data has arrived, never blocks.
+     */
+    bool ready() const { return _state && _state->ready; }
+
+    /**
+     * @brief Gets the size of the read range in bytes.
+     */
+    int64_t size() const { return _state ? static_cast<int64_t>(_state->data.size()) : 0; }
+
+    /**
+     * @brief Gets the read data.
+     *
+     * @throws std::logic_error If the readback is not ready()
+     */
+    const std::vector<char>& data() const {
+        if (!ready())
+            throw std::logic_error("Readback is not ready!");
+        return _state->data;
+    }
+
+    /**
+     * @brief Gets the read data as a value of type T, for example an atomic counter.
+     *
+     * @throws std::logic_error If the readback is not ready()
+     * @throws std::length_error If the size of the read range is not sizeof(T)
+     */
+    template <typename T>
+    T get() const {
+        const std::vector<char>& bytes = data();
+        if (bytes.size() != sizeof(T))
+            throw std::length_error("Size of the readback does not match the size of the requested type!");
+        T value;
+        std::memcpy(&value, bytes.data(), sizeof(T));
+        return value;
+    }
+};
+
+/**
+ * @brief Statistics of a ReadbackQueue, mainly used to size it properly.
+ */
+struct ReadbackQueueStats {
+    uint64_t requests = 0;          ///< Number of readbacks requested.
+    uint64_t completed = 0;         ///< Number of readbacks resolved.
+    uint64_t bytesRead = 0;         ///< Number of bytes resolved.
+    uint64_t stalls = 0;            ///< Number of times a request had to wait on the GPU because the queue was full.
+    double stallMilliseconds = 0.0; ///< Total time spent waiting on the GPU.
+    uint32_t inFlight = 0;          ///< Number of readbacks currently in flight.
+    uint32_t peakInFlight = 0;      ///< Highest number of readbacks in flight at once.
+};
+
+/**
+ * @brief Bounded queue of asynchronous Buffer readbacks.
+ *
+ * Buffer::readAsync copies the requested range into a persistently mapped staging Buffer on the GPU and guards it
+ * with a Fence. poll() resolves every readback whose Fence has been passed without ever waiting, so results arrive
+ * frames later without draining the pipeline. Only if the staging memory or the in-flight limit is exhausted does a
+ * new request wait for the oldest one (backpressure), which is counted in the statistics.
+ *
+ * @warning ReadbackQueue must be deconstructed before the OpenGL context is destroyed.
+ * @warning This class is not guaranteed to be thread-safe.
+ *
+ * @note Call poll() once per frame.
+ */
+class ReadbackQueue {
+protected:
+    struct _Request {
+        Fence fence;
+        int64_t begin;  // monotonic position of the reserved staging range
+        int64_t offset; // offset into the staging Buffer
+        std::shared_ptr<Readback::_State> state;
+    };
+
+    Buffer _staging;
+    const char* _data = nullptr;
+    int64_t _capacity = 0;
+    uint32_t _maxInFlight = 0;
+    int64_t _head = 0; // monotonic write position
+    std::deque<_Request> _inFlight = {};
+    ReadbackQueueStats _stats = {};
+
+    void _resolveFront();
+    int64_t _reserve(int64_t size, int64_t& begin);
+    Readback _submit(int64_t begin, int64_t offset, int64_t size);
+
+    friend class Buffer;
+
+public:
+    ReadbackQueue() = delete;
+    /**
+     * @brief Construct a new ReadbackQueue.
+     *
+     * @throws std::invalid_argument If capacity is not greater than 0
+     * @throws std::invalid_argument If maxInFlight is 0
+     * @throws std::runtime_error If the staging Buffer could not be created or mapped
+     *
+     * @param capacity The size of the staging memory in bytes (should hold all readbacks of a few frames)
+     * @param maxInFlight The maximum number of unresolved readbacks
+     */
+    ReadbackQueue(int64_t capacity, uint32_t maxInFlight = 64);
+    ReadbackQueue(ReadbackQueue&& other) = default;
+    ReadbackQueue(const ReadbackQueue& other) = delete;
+
+    /**
+     * @brief Resolves all readbacks the GPU has finished, never blocks.
+     *
+     * @returns The number of resolved readbacks
+     */
+    uint32_t poll();
+
+    /**
+     * @brief Waits for and resolves all readbacks in flight.
+     */
+    void finish();
+
+    int64_t capacity() const { return _capacity; }          ///< Gets the size of the staging memory in bytes.
+    uint32_t maxInFlight() const { return _maxInFlight; }   ///< Gets the maximum number of unresolved readbacks.
+
+    /**
+     * @brief Gets the statistics.
+     */
+    const ReadbackQueueStats& stats() const { return _stats; }
+
+    /**
+     * @brief Resets the statistics, except for the number of readbacks in flight.
+     */
+    void resetStats() { _stats = { .inFlight = _stats.inFlight }; }
+
+    ReadbackQueue& operator=(ReadbackQueue&& other) = default;
+    ReadbackQueue& operator=(const ReadbackQueue& other) = delete;
+};
+
+}
+
+#endif
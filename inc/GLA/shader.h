@@ -7,6 +7,7 @@
 
 namespace gla {
 
+class DeletionQueue;
 class Program;
 
 /**
@@ -63,13 +64,14 @@ public:
  * @warning This class is not guaranteed to be thread-safe.
  * 
  * @note This class owns the underlying OpenGL Shader object and
- *       releases it upon destruction or reset().
+ *       releases it upon destruction or reset() through the gla::DeletionQueue of the context it was created in.
  */
 class Shader {
 protected:
     unsigned int _id = 0;
     ShaderType _type;
     bool _compiled = false;
+    DeletionQueue* _deletionQueue = nullptr; // of the context the shader object was created in
 
     void _delete();
     void _check();
@@ -0,0 +1,118 @@
+#ifndef GLA_SPARSE_BUFFER_H
+#define GLA_SPARSE_BUFFER_H
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <GLA/buffer.h>
+
+namespace gla {
+
+/**
+ * @brief Huge virtual Buffer whose pages are committed on demand.
+ *
+ * With Capabilities::sparseBuffer the whole range is one Buffer allocated with BufferFlag::Sparse and commit() /
+ * decommit() map to Buffer::commitPages. Without it, for example under Mesa llvmpipe, every page is a separate
+ * Buffer created on commit and destroyed on decommit, so the same code runs everywhere with a coarser page size.
+ * A residency bitmap tracks the committed pages in both cases.
+ *
+ * @warning SparseBuffer must be deconstructed before the OpenGL context is destroyed.
+ * @warning This class is not guaranteed to be thread-safe.
+ *
+ * @note Use locate() to get the Buffer and offset to bind or update a range, in the fallback a range may not
+ *       cross a page boundary.
+ */
+class SparseBuffer {
+protected:
+    BufferType _type;
+    int64_t _size = 0;
+    int64_t _pageSize = 0;
+    bool _sparse = false;
+    Buffer _buffer;                                 // sparse storage, empty in the fallback
+    std::vector<std::unique_ptr<Buffer>> _pages = {}; // fallback storage, one Buffer per committed page
+    std::vector<uint64_t> _residency = {};
+    int64_t _committedPages = 0;
+
+    bool _resident(int64_t page) const { return (_residency[page / 64] >> (page % 64)) & 1; }
+    void _pageRange(int64_t offset, int64_t size, int64_t& first, int64_t& last) const;
+    void _setResidency(int64_t first, int64_t last, bool commit);
+
+public:
+    SparseBuffer() = delete;
+    /**
+     * @brief Construct a new SparseBuffer, reserving address space but committing no pages.
+     *
+     * @throws std::invalid_argument If size is not greater than 0
+     * @throws std::invalid_argument If fallbackPageSize is not greater than 0
+     * @throws std::runtime_error If the Buffer could not be created
+     *
+     * @param type The BufferType of the storage
+     * @param size The virtual size in bytes, rounded up to whole pages
+     * @param fallbackPageSize The page size used without Capabilities::sparseBuffer, every page is a Buffer of this size
+     */
+    SparseBuffer(BufferType type, int64_t size, int64_t fallbackPageSize = 64ll * 1024 * 1024);
+    SparseBuffer(SparseBuffer&& other) = default;
+    SparseBuffer(const SparseBuffer& other) = delete;
+
+    /**
+     * @brief Commits all pages overlapping the range, pages that are already committed are kept.
+     *
+     * @throws std::runtime_error If the range is outside of the SparseBuffer or size is not greater than 0
+     *
+     * @param offset The offset of the range in bytes
+     * @param size The size of the range in bytes
+     */
+    void commit(int64_t offset, int64_t size);
+
+    /**
+     * @brief Releases all pages overlapping the range, their contents are lost.
+     *
+     * @throws std::runtime_error If the range is outside of the SparseBuffer or size is not greater than 0
+     *
+     * @param offset The offset of the range in bytes
+     * @param size The size of the range in bytes
+     */
+    void decommit(int64_t offset, int64_t size);
+
+    /**
+     * @brief Checks if all pages overlapping the range are committed.
+     *
+     * @throws std::runtime_error If the range is outside of the SparseBuffer or size is not greater than 0
+     */
+    bool resident(int64_t offset, int64_t size) const;
+
+    /**
+     * @brief Gets the Buffer and offset backing a committed range.
+     *
+     * @throws std::runtime_error If the range is outside of the SparseBuffer or size is not greater than 0
+     * @throws std::runtime_error If the range is not resident
+     * @throws std::runtime_error If the range crosses a page boundary in the fallback
+     *
+     * @param offset The offset of the range in bytes
+     * @param size The size of the range in bytes
+     *
+     * @returns The slice to bind or update
+     */
+    BufferSlice locate(int64_t offset, int64_t size);
+
+    /**
+     * @brief Gets the residency bitmap, bit i % 64 of word i / 64 is set if page i is committed.
+     */
+    const std::vector<uint64_t>& residency() const { return _residency; }
+
+    bool sparse() const { return _sparse; }                                 ///< Checks if ARB_sparse_buffer is used instead of the fallback.
+    int64_t size() const { return _size; }                                  ///< Gets the virtual size in bytes.
+    int64_t pageSize() const { return _pageSize; }                          ///< Gets the commit granularity in bytes.
+    int64_t pageCount() const { return _size / _pageSize; }                 ///< Gets the number of pages.
+    int64_t committedPages() const { return _committedPages; }              ///< Gets the number of committed pages.
+    int64_t committedBytes() const { return _committedPages * _pageSize; }  ///< Gets the number of committed bytes.
+
+    SparseBuffer& operator=(SparseBuffer&& other) = default;
+    SparseBuffer& operator=(const SparseBuffer& other) = delete;
+};
+
+}
+
+#endif
@@ -0,0 +1,116 @@
+#ifndef GLA_STATE_CACHE_H
+#define GLA_STATE_CACHE_H
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <GLA/buffer.h>
+
+namespace gla {
+
+/**
+ * @brief Counters of a StateCache.
+ */
+struct StateCacheStats {
+    uint64_t issued = 0; ///< Number of bind calls forwarded to OpenGL.
+    uint64_t elided = 0; ///< Number of bind calls skipped because they would not change anything.
+};
+
+/**
+ * @brief Shadows the OpenGL binding state of one context and skips redundant bind calls.
+ *
+ * Tracks the current Program, the VAO, the Buffer bound to each BufferType and the indexed Buffer bindings.
+ * All binds of the abstraction go through the StateCache of the current thread, which gla::WindowContext
+ * sets up in WindowContext::useContext.
+ *
+ * @warning Call invalidate() after changing bindings with raw OpenGL calls, otherwise later binds may be skipped wrongly.
+ * @warning This class is not guaranteed to be thread-safe, OpenGL contexts are bound to one thread anyway.
+ */
+class StateCache {
+protected:
+    static constexpr unsigned int _UNKNOWN = 0xFFFFFFFF;
+    static constexpr int _BUFFER_TYPES = static_cast<int>(BufferType::Uniform) + 1;
+
+    struct _IndexedBinding {
+        unsigned int id;
+        int64_t offset;
+        int64_t size; // -1 for glBindBufferBase
+    };
+
+    unsigned int _program = _UNKNOWN;
+    unsigned int _vertexArray = _UNKNOWN;
+    unsigned int _buffers[_BUFFER_TYPES];
+    std::vector<_IndexedBinding> _indexed[_BUFFER_TYPES];
+    StateCacheStats _stats = {};
+
+    bool _setIndexed(BufferType type, unsigned int index, unsigned int id, int64_t offset, int64_t size, bool generic);
+
+public:
+    /**
+     * @brief Construct a new StateCache with all state unknown.
+     */
+    StateCache();
+
+    /**
+     * @brief Gets the StateCache of the context current on the calling thread.
+     *
+     * @note If no cache was made current, a per-thread fallback cache is returned.
+     */
+    static StateCache& current();
+
+    /**
+     * @brief Makes the given cache the current one of the calling thread.
+     *
+     * @param cache The cache to make current, nullptr to use the per-thread fallback cache
+     */
+    static void makeCurrent(StateCache* cache);
+
+    /**
+     * @brief Checks if the given cache is the current one of the calling thread.
+     */
+    static bool isCurrent(const StateCache* cache);
+
+    void useProgram(unsigned int id);                                   ///< glUseProgram unless id is already in use.
+    void bindVertexArray(unsigned int id);                              ///< glBindVertexArray unless id is already bound.
+    unsigned int vertexArray();                                         ///< Gets the bound VAO, queried from OpenGL if unknown.
+    void bindBuffer(BufferType type, unsigned int id);                  ///< glBindBuffer unless id is already bound to the target.
+    void bindBufferBase(BufferType type, unsigned int index, unsigned int id); ///< glBindBufferBase unless id is already bound to the index.
+    void bindBufferRange(BufferType type, unsigned int index, unsigned int id, int64_t offset, int64_t size); ///< glBindBufferRange unless the range is already bound to the index.
+
+    /**
+     * @brief Binds ranges to consecutive indexed binding points with one glBindBuffersRange call, unless all are already bound.
+     *
+     * @note Falls back to one bindBufferRange per range without Capabilities::multiBind.
+     *
+     * @param type The BufferType of the binding points
+     * @param first The index of the first binding point
+     * @param ids The Buffer ids, one per binding point
+     * @param offsets The offsets of the ranges in bytes, as many as ids
+     * @param sizes The sizes of the ranges in bytes, as many as ids
+     */
+    void bindBuffersRange(BufferType type, unsigned int first, std::span<const unsigned int> ids, std::span<const int64_t> offsets, std::span<const int64_t> sizes);
+
+    /**
+     * @brief Marks all state as unknown, so the next bind of every kind is issued.
+     */
+    void invalidate();
+
+    void forgetProgram(unsigned int id);        ///< Marks state referring to a deleted Program as unknown.
+    void forgetVertexArray(unsigned int id);    ///< Marks state referring to a deleted VAO as unknown.
+    void forgetBuffer(unsigned int id);         ///< Marks state referring to a deleted Buffer as unknown.
+
+    /**
+     * @brief Gets the counters of issued and elided calls.
+     */
+    const StateCacheStats& stats() const { return _stats; }
+
+    /**
+     * @brief Resets the counters.
+     */
+    void resetStats() { _stats = {}; }
+};
+
+}
+
+#endif
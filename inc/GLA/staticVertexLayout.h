@@ -0,0 +1,143 @@
+#ifndef GLA_STATIC_VERTEX_LAYOUT_H
+#define GLA_STATIC_VERTEX_LAYOUT_H
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+
+#include <GLA/vertexArray.h>
+
+namespace gla {
+
+/**
+ * @brief Describes how a scalar type is fed to a vertex attribute, specialize it for custom types.
+ *
+ * Specializations provide supported, type and interp.
+ */
+template <typename T>
+struct VertexScalarTraits {
+    static constexpr bool supported = false;
+};
+
+template <> struct VertexScalarTraits<float>    { static constexpr bool supported = true; static constexpr VertexAttribType type = VertexAttribType::Float;         static constexpr VertexAttribInterp interp = VertexAttribInterp::Float; };
+template <> struct VertexScalarTraits<double>   { static constexpr bool supported = true; static constexpr VertexAttribType type = VertexAttribType::Double;        static constexpr VertexAttribInterp interp = VertexAttribInterp::Float; };
+template <> struct VertexScalarTraits<int8_t>   { static constexpr bool supported = true; static constexpr VertexAttribType type = VertexAttribType::Byte;          static constexpr VertexAttribInterp interp = VertexAttribInterp::Integer; };
+template <> struct VertexScalarTraits<uint8_t>  { static constexpr bool supported = true; static constexpr VertexAttribType type = VertexAttribType::UnsignedByte;  static constexpr VertexAttribInterp interp = VertexAttribInterp::Integer; };
+template <> struct VertexScalarTraits<int16_t>  { static constexpr bool supported = true; static constexpr VertexAttribType type = VertexAttribType::Short;         static constexpr VertexAttribInterp interp = VertexAttribInterp::Integer; };
+template <> struct VertexScalarTraits<uint16_t> { static constexpr bool supported = true; static constexpr VertexAttribType type = VertexAttribType::UnsignedShort; static constexpr VertexAttribInterp interp = VertexAttribInterp::Integer; };
+template <> struct VertexScalarTraits<int32_t>  { static constexpr bool supported = true; static constexpr VertexAttribType type = VertexAttribType::Int;           static constexpr VertexAttribInterp interp = VertexAttribInterp::Integer; };
+template <> struct VertexScalarTraits<uint32_t> { static constexpr bool supported = true; static constexpr VertexAttribType type = VertexAttribType::UnsignedInt;   static constexpr VertexAttribInterp interp = VertexAttribInterp::Integer; };
+
+/**
+ * @brief Describes how a vertex member type maps to a vertex attribute, scalars, arrays of scalars and glm vectors are supported.
+ *
+ * Specializations provide supported, type, interp and components.
+ */
+template <typename T>
+struct VertexAttribTraits : VertexScalarTraits<T> {
+    static constexpr int components = 1;
+};
+
+template <glm::length_t L, typename T, glm::qualifier Q>
+struct VertexAttribTraits<glm::vec<L, T, Q>> : VertexScalarTraits<T> {
+    static constexpr int components = L;
+};
+
+template <typename T, size_t N>
+struct VertexAttribTraits<T[N]> : VertexScalarTraits<T> {
+    static constexpr int components = static_cast<int>(N);
+};
+
+/**
+ * @brief Vertex attributes of a vertex struct that were validated at compile time, see gla::staticVertexLayout.
+ *
+ * Applied with VertexArray::setAttributes, VertexArrayObject::setVertexBuffer or the VertexLayout constructor
+ * without any runtime validation.
+ */
+template <typename Vertex, size_t N>
+struct StaticVertexLayout {
+    std::array<VertexAttribute, N> attributes;
+
+    static constexpr int stride = static_cast<int>(sizeof(Vertex)); ///< The distance between two vertices in bytes.
+};
+
+/**
+ * @brief Builds the VertexAttribute of a vertex member from its type, see GLA_ATTRIBUTE.
+ *
+ * The member type must have a VertexAttribTraits specialization, otherwise compilation fails.
+ *
+ * @param index The VertexAttribute location in the GLSL shader program
+ * @param offset The offset of the member in the vertex struct
+ * @param normalized If integer members should be mapped to [-1;1] or [0;1] floats
+ */
+template <typename T>
+consteval VertexAttribute vertexAttribute(unsigned int index, size_t offset, bool normalized = false) {
+    using Traits = VertexAttribTraits<std::remove_cv_t<T>>;
+    static_assert(Traits::supported, "The member type has no gla::VertexAttribTraits specialization!");
+    VertexAttribInterp interp = normalized ? VertexAttribInterp::Float : Traits::interp;
+    return { index, Traits::components, Traits::type, interp, normalized, static_cast<int>(offset) };
+}
+
+/**
+ * @brief Validates the attributes of a vertex struct at compile time and stores them as a StaticVertexLayout.
+ *
+ * Invalid layouts fail to compile at the throw that names the problem: indices at or above the 16 guaranteed
+ * attribute locations, duplicated indices, component counts outside of [1;4], invalid type and interpretation
+ * combinations, attributes extending over sizeof(Vertex) and overlapping attributes.
+ *
+ * @code
+ * constexpr auto layout = gla::staticVertexLayout<Vertex>(GLA_ATTRIBUTE(Vertex, pos, 0), GLA_NORMALIZED_ATTRIBUTE(Vertex, color, 1));
+ * @endcode
+ */
+template <typename Vertex, std::same_as<VertexAttribute>... Attributes>
+consteval StaticVertexLayout<Vertex, sizeof...(Attributes)> staticVertexLayout(Attributes... attributes) {
+    constexpr unsigned int guaranteedAttributes = 16;
+    StaticVertexLayout<Vertex, sizeof...(Attributes)> layout = { { attributes... } };
+    for (size_t i = 0; i < layout.attributes.size(); i++) {
+        const VertexAttribute& attrib = layout.attributes[i];
+        if (attrib.index >= guaranteedAttributes)
+            throw std::invalid_argument("Only the attribute indices 0 to 15 are guaranteed!");
+        if (attrib.numComponents > 4 || attrib.numComponents <= 0)
+            throw std::invalid_argument("numComponents of VertexAttribute may only be 1 to 4!");
+        if (!validateTypeComponents(attrib.type, attrib.numComponents))
+            throw std::invalid_argument("Packed VertexAttribTypes need 4 components (2_10_10_10) or 3 components (10F_11F_11F)!");
+        std::string error;
+        if (!validateTypeInterpretation(attrib.type, attrib.interp, error))
+            throw std::invalid_argument("Invalid combination of type and interpretation!");
+        int end = attrib.offset + attributeBytes(attrib.type, attrib.numComponents);
+        if (attrib.offset < 0 || end > layout.stride)
+            throw std::invalid_argument("Given VertexAttributes are bigger than the stride!");
+        for (size_t j = 0; j < layout.attributes.size(); j++) {
+            if (i == j) continue;
+            const VertexAttribute& other = layout.attributes[j];
+            if (attrib.index == other.index)
+                throw std::invalid_argument("VertexAttributes use the same index!");
+            if (attrib.offset <= other.offset && end > other.offset)
+                throw std::invalid_argument("VertexAttributes overlap!");
+        }
+    }
+    return layout;
+}
+
+}
+
+/** \def GLA_ATTRIBUTE(Vertex, member, index)
+ * @brief Builds the VertexAttribute of a member of a vertex struct from its type and offset.
+ */
+
+/** \def GLA_NORMALIZED_ATTRIBUTE(Vertex, member, index)
+ * @brief Builds the VertexAttribute of an integer member of a vertex struct that is read as a normalized float.
+ */
+
+#define GLA_ATTRIBUTE(Vertex, member, index) ::gla::vertexAttribute<decltype(Vertex::member)>(index, offsetof(Vertex, member))
+
+#define GLA_NORMALIZED_ATTRIBUTE(Vertex, member, index) ::gla::vertexAttribute<decltype(Vertex::member)>(index, offsetof(Vertex, member), true)
+
+#endif
@@ -0,0 +1,130 @@
+#ifndef GLA_STREAMING_BUFFER_H
+#define GLA_STREAMING_BUFFER_H
+
+#include <cstdint>
+#include <deque>
+#include <stdexcept>
+
+#include <GLA/buffer.h>
+#include <GLA/fence.h>
+
+namespace gla {
+
+/**
+ * @brief A sub-region of a StreamingBuffer handed out by StreamingBuffer::allocate.
+ */
+struct StreamingAllocation {
+    int64_t offset; ///< Offset of the region into the underlying Buffer in bytes.
+    int64_t size;   ///< Size of the region in bytes.
+    void* data;     ///< Persistently mapped pointer to the start of the region.
+};
+
+/**
+ * @brief Usage statistics of a StreamingBuffer, mainly used to size it properly.
+ */
+struct StreamingBufferStats {
+    uint64_t allocations = 0;       ///< Number of regions handed out.
+    uint64_t bytesAllocated = 0;    ///< Number of bytes handed out (excluding alignment padding).
+    uint64_t wraps = 0;             ///< Number of times the write position wrapped around to the start.
+    uint64_t fences = 0;            ///< Number of fences inserted.
+    uint64_t stalls = 0;            ///< Number of times the CPU had to wait on the GPU.
+    double stallMilliseconds = 0.0; ///< Total time spent waiting on the GPU.
+};
+
+/**
+ * @brief Persistently mapped ring buffer for streaming dynamic data to the GPU.
+ *
+ * The storage is allocated once through Buffer::setStorage with BufferFlag::MapWrite | MapPersistent | MapCoherent
+ * and stays mapped for the lifetime of the StreamingBuffer. Regions are handed out linearly and every call to fence()
+ * guards the regions handed out since the previous call with a Fence. The CPU only waits on the GPU if an allocation
+ * would overwrite a region the GPU may still be reading.
+ *
+ * @warning StreamingBuffer must be deconstructed before the OpenGL context is destroyed.
+ * @warning This class is not guaranteed to be thread-safe.
+ *
+ * @note Call fence() once per frame after the draws consuming the allocated regions have been issued.
+ */
+class StreamingBuffer {
+protected:
+    struct _Region {
+        Fence fence;
+        int64_t begin; // monotonic write position
+        int64_t end;   // monotonic write position
+    };
+
+    Buffer _buffer;
+    char* _data = nullptr;
+    int64_t _capacity = 0;
+    int64_t _head = 0;      // monotonic write position, the buffer offset is _head % _capacity
+    int64_t _fencedEnd = 0; // monotonic write position up to which regions are guarded by a fence
+    std::deque<_Region> _regions = {};
+    StreamingBufferStats _stats = {};
+
+    void _waitUntilFree(int64_t position);
+
+public:
+    StreamingBuffer() = delete;
+    /**
+     * @brief Construct a new StreamingBuffer with the given binding type and capacity.
+     *
+     * @throws std::invalid_argument If capacity is not greater than 0
+     * @throws std::runtime_error If the Buffer could not be created or mapped
+     *
+     * @param type The binding point of the underlying Buffer
+     * @param capacity The size of the ring in bytes (should hold at least two frames of data to avoid stalls)
+     */
+    StreamingBuffer(BufferType type, int64_t capacity);
+    StreamingBuffer(StreamingBuffer&& other);
+    StreamingBuffer(const StreamingBuffer& other) = delete;
+
+    /**
+     * @brief Hands out a region of the ring buffer to write to.
+     *
+     * @note Regions never wrap around the end of the Buffer, they are always contiguous.
+     *
+     * @throws std::invalid_argument If size is not greater than 0 or greater than capacity()
+     * @throws std::invalid_argument If alignment is not a power of two
+     * @throws std::runtime_error If the allocation would overwrite a region of the current frame (capacity is too small)
+     * @throws std::runtime_error If waiting on the GPU failed
+     *
+     * @param size The size of the region in bytes
+     * @param alignment The alignment of the offset of the region in bytes
+     *
+     * @returns The allocated region, valid until the GPU has passed the next fence()
+     */
+    StreamingAllocation allocate(int64_t size, int64_t alignment = 1);
+
+    /**
+     * @brief Guards all regions allocated since the last call with a Fence.
+     *
+     * @throws std::runtime_error If OpenGL failed to create a sync object.
+     */
+    void fence();
+
+    /**
+     * @brief Gets the underlying Buffer, for example to bind it.
+     */
+    const Buffer& buffer() const { return _buffer; }
+
+    /**
+     * @brief Gets the size of the ring in bytes.
+     */
+    int64_t capacity() const { return _capacity; }
+
+    /**
+     * @brief Gets the usage statistics.
+     */
+    const StreamingBufferStats& stats() const { return _stats; }
+
+    /**
+     * @brief Resets the usage statistics.
+     */
+    void resetStats() { _stats = {}; }
+
+    StreamingBuffer& operator=(StreamingBuffer&& other);
+    StreamingBuffer& operator=(const StreamingBuffer& other) = delete;
+};
+
+}
+
+#endif
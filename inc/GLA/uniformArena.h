@@ -0,0 +1,149 @@
+#ifndef GLA_UNIFORM_ARENA_H
+#define GLA_UNIFORM_ARENA_H
+
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include <GLA/buffer.h>
+#include <GLA/fence.h>
+
+namespace gla {
+
+/**
+ * @brief Statistics of a UniformArena, mainly used to size it properly.
+ */
+struct UniformArenaStats {
+    uint64_t allocations = 0;       ///< Number of ranges handed out.
+    uint64_t bytesAllocated = 0;    ///< Number of bytes handed out (excluding alignment padding).
+    int64_t peakFrameBytes = 0;     ///< Highest number of bytes used in one frame (including alignment padding).
+    uint64_t stalls = 0;            ///< Number of times endFrame() had to wait on the GPU.
+    double stallMilliseconds = 0.0; ///< Total time spent waiting on the GPU.
+};
+
+/**
+ * @brief Per-frame bump allocator for uniform and shader storage block data.
+ *
+ * One persistently mapped Buffer is split into a segment per frame in flight (three by default). allocate() bumps
+ * a pointer through the segment of the current frame, respecting the offset alignment of the target, and the ranges
+ * are bound with glBindBufferRange or, for all blocks of a draw at once, glBindBuffersRange.
+ * endFrame() fences the segment and moves on to the next one, which only waits if the GPU is frames behind.
+ *
+ * @warning UniformArena must be deconstructed before the OpenGL context is destroyed.
+ * @warning This class is not guaranteed to be thread-safe.
+ *
+ * @note Call endFrame() once per frame after the draws using the allocated ranges have been issued.
+ */
+class UniformArena {
+protected:
+    Buffer _buffer;
+    char* _data = nullptr;
+    int64_t _frameSize = 0;
+    uint32_t _frame = 0;
+    int64_t _head = 0; // offset into the segment of the current frame
+    std::vector<Fence> _fences = {};
+    UniformArenaStats _stats = {};
+
+public:
+    UniformArena() = delete;
+    /**
+     * @brief Construct a new UniformArena.
+     *
+     * @throws std::invalid_argument If frameSize is not greater than 0
+     * @throws std::invalid_argument If frames is 0
+     * @throws std::runtime_error If the Buffer could not be created or mapped
+     *
+     * @param frameSize The number of bytes available per frame
+     * @param frames The number of frames in flight
+     */
+    UniformArena(int64_t frameSize, uint32_t frames = 3);
+    UniformArena(UniformArena&& other) = default;
+    UniformArena(const UniformArena& other) = delete;
+
+    /**
+     * @brief Hands out a range of the current frame.
+     *
+     * @throws std::logic_error If type is neither BufferType::Uniform nor BufferType::ShaderStorage
+     * @throws std::invalid_argument If size is not greater than 0
+     * @throws std::runtime_error If the segment of the current frame is full
+     *
+     * @param size The size of the range in bytes
+     * @param type The target the range is bound to, selects the offset alignment
+     *
+     * @returns The range as BufferSlice, its data is at data(slice) and valid until the frame has been ended
+     */
+    BufferSlice allocate(int64_t size, BufferType type = BufferType::Uniform);
+
+    /**
+     * @brief Allocates a range and copies a value into it.
+     *
+     * @param value The block data, for example a std140 layout struct
+     * @param type The target the range is bound to, selects the offset alignment
+     */
+    template <typename T>
+    BufferSlice push(const T& value, BufferType type = BufferType::Uniform) {
+        static_assert(std::is_trivially_copyable_v<T>, "Block data must be trivially copyable!");
+        BufferSlice slice = allocate(sizeof(T), type);
+        std::memcpy(data(slice), &value, sizeof(T));
+        return slice;
+    }
+
+    /**
+     * @brief Gets the mapped pointer to a range handed out by this arena.
+     */
+    void* data(const BufferSlice& slice) const { return _data + slice.offset; }
+
+    /**
+     * @brief Binds a range with glBindBufferRange.
+     *
+     * @param type BufferType::Uniform or BufferType::ShaderStorage
+     * @param index The index of the binding point
+     * @param slice The range handed out by this arena
+     */
+    void bind(BufferType type, unsigned int index, const BufferSlice& slice) const { _buffer.bindRange(type, index, slice.offset, slice.size); }
+
+    /**
+     * @brief Binds ranges to consecutive binding points, in one glBindBuffersRange call if Capabilities::multiBind is available.
+     *
+     * @param type BufferType::Uniform or BufferType::ShaderStorage
+     * @param first The index of the first binding point
+     * @param slices The ranges handed out by this arena
+     */
+    void bind(BufferType type, unsigned int first, std::span<const BufferSlice> slices) const { Buffer::bindRanges(type, first, slices); }
+
+    /**
+     * @brief Fences the current frame and moves on to the segment of the next one, waiting if the GPU still uses it.
+     *
+     * @throws std::runtime_error If waiting on the GPU failed
+     */
+    void endFrame();
+
+    /**
+     * @brief Gets the underlying Buffer.
+     */
+    const Buffer& buffer() const { return _buffer; }
+
+    int64_t frameSize() const { return _frameSize; }                                        ///< Gets the number of bytes available per frame.
+    uint32_t frames() const { return static_cast<uint32_t>(_fences.size()); }               ///< Gets the number of frames in flight.
+    int64_t frameBytesUsed() const { return _head; }                                        ///< Gets the number of bytes used in the current frame.
+
+    /**
+     * @brief Gets the statistics.
+     */
+    const UniformArenaStats& stats() const { return _stats; }
+
+    /**
+     * @brief Resets the statistics.
+     */
+    void resetStats() { _stats = {}; }
+
+    UniformArena& operator=(UniformArena&& other) = default;
+    UniformArena& operator=(const UniformArena& other) = delete;
+};
+
+}
+
+#endif
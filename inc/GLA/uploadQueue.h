@@ -0,0 +1,181 @@
+#ifndef GLA_UPLOAD_QUEUE_H
+#define GLA_UPLOAD_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <GLA/buffer.h>
+#include <GLA/fence.h>
+
+namespace gla {
+
+/**
+ * @brief Staging memory handed out by UploadQueue::reserve, to be filled and then submitted or cancelled.
+ */
+struct UploadReservation {
+    void* data = nullptr;   ///< Persistently mapped pointer to the reserved memory, nullptr if the reservation failed.
+    int64_t offset = 0;     ///< Offset of the reserved memory into the staging Buffer in bytes.
+    int64_t size = 0;       ///< Size of the reserved memory in bytes.
+    int64_t begin = 0;      ///< Monotonic position of the reserved span including its alignment padding.
+    int64_t end = 0;        ///< Monotonic position past the end of the reserved span.
+
+    /**
+     * @brief Checks if the reservation succeeded.
+     */
+    bool valid() const { return data != nullptr; }
+
+    /**
+     * @brief Gets the reserved memory as bytes.
+     */
+    std::span<std::byte> bytes() const { return { static_cast<std::byte*>(data), static_cast<size_t>(size) }; }
+};
+
+/**
+ * @brief Statistics of an UploadQueue.
+ */
+struct UploadQueueStats {
+    uint64_t reservations = 0;          ///< Number of successful reservations.
+    uint64_t failedReservations = 0;    ///< Number of reservations that failed because the staging memory was full.
+    uint64_t bytesReserved = 0;         ///< Number of bytes reserved (excluding alignment padding).
+    uint64_t uploads = 0;               ///< Number of submitted uploads copied by flush().
+    uint64_t cancelled = 0;             ///< Number of cancelled reservations.
+    uint64_t bytesUploaded = 0;         ///< Number of bytes copied by flush().
+    uint64_t flushes = 0;               ///< Number of calls to flush().
+    double lastFlushMicroseconds = 0.0; ///< Time the GL thread spent in the last flush().
+};
+
+/**
+ * @brief Lets worker threads fill staging memory while the GL thread only issues the copies.
+ *
+ * The staging memory is a ring in a persistently mapped Buffer. Any thread may reserve() a span of it without
+ * locking, write or decode into it and then submit() it together with a destination Buffer. Once per frame the GL
+ * thread calls flush(), which turns all submitted uploads into batched glCopyBufferSubData calls guarded by a Fence.
+ * Spans are recycled once the GPU has passed the Fence of their copies and all earlier spans are recycled as well.
+ *
+ * @warning UploadQueue must be deconstructed before the OpenGL context is destroyed, after all workers stopped using it.
+ * @warning The constructor, flush() and finish() must be called on the thread the OpenGL context is current on.
+ *
+ * @note reserve(), submit() and cancel() are thread-safe.
+ * @note Every successful reservation must eventually be submitted or cancelled, otherwise the ring never advances past it.
+ */
+class UploadQueue {
+protected:
+    struct _Submission {
+        int64_t begin;
+        int64_t end;
+        Buffer* dst; // nullptr for cancelled reservations
+        int64_t srcOffset;
+        int64_t dstOffset;
+        int64_t size;
+    };
+
+    struct _Batch {
+        Fence fence;
+        std::vector<std::pair<int64_t, int64_t>> spans;
+    };
+
+    Buffer _staging;
+    char* _data = nullptr;
+    int64_t _capacity = 0;
+
+    // shared with the workers
+    std::atomic<int64_t> _head = 0; // monotonic reserve position
+    std::atomic<int64_t> _tail = 0; // monotonic position before which all spans are free again
+    std::mutex _mutex;
+    std::vector<_Submission> _submitted = {};
+    std::atomic<uint64_t> _reservations = 0;
+    std::atomic<uint64_t> _failedReservations = 0;
+    std::atomic<uint64_t> _bytesReserved = 0;
+
+    // only touched by the GL thread
+    std::deque<_Batch> _batches = {};
+    std::map<int64_t, int64_t> _retired = {}; // recycled spans that can't be released yet because an earlier one is still in use
+    UploadQueueStats _stats = {};
+
+    void _retire(int64_t begin, int64_t end);
+    void _advanceTail();
+
+public:
+    UploadQueue() = delete;
+    /**
+     * @brief Construct a new UploadQueue.
+     *
+     * @throws std::invalid_argument If capacity is not greater than 0
+     * @throws std::runtime_error If the staging Buffer could not be created or mapped
+     *
+     * @param capacity The size of the staging memory in bytes
+     */
+    UploadQueue(int64_t capacity);
+    UploadQueue(UploadQueue&& other) = delete;
+    UploadQueue(const UploadQueue& other) = delete;
+
+    /**
+     * @brief Reserves staging memory without blocking, may be called from any thread.
+     *
+     * @throws std::invalid_argument If size is not greater than 0 or greater than the capacity
+     * @throws std::invalid_argument If alignment is not greater than 0
+     *
+     * @param size The size of the memory in bytes
+     * @param alignment The alignment of the offset into the staging Buffer in bytes
+     *
+     * @returns The reservation, invalid if the staging memory is currently full (try again after the next flush)
+     */
+    UploadReservation reserve(int64_t size, int64_t alignment = 16);
+
+    /**
+     * @brief Queues the copy of a filled reservation into a Buffer, may be called from any thread.
+     *
+     * @throws std::logic_error If the reservation is invalid
+     * @throws std::runtime_error If dstOffset is negativ or the range is outside of dst
+     *
+     * @param reservation The filled reservation, invalid afterwards
+     * @param dst The destination Buffer, must stay alive and keep its size until the copy was flushed
+     * @param dstOffset The offset into dst in bytes
+     */
+    void submit(UploadReservation& reservation, Buffer& dst, int64_t dstOffset);
+
+    /**
+     * @brief Gives a reservation back without copying it, may be called from any thread.
+     *
+     * @throws std::logic_error If the reservation is invalid
+     *
+     * @param reservation The reservation, invalid afterwards
+     */
+    void cancel(UploadReservation& reservation);
+
+    /**
+     * @brief Issues the copies of all submitted uploads and recycles staging memory the GPU is done with.
+     *
+     * @note Call once per frame on the GL thread, never blocks.
+     */
+    void flush();
+
+    /**
+     * @brief Flushes and waits until the GPU has executed all copies.
+     */
+    void finish();
+
+    /**
+     * @brief Gets the size of the staging memory in bytes.
+     */
+    int64_t capacity() const { return _capacity; }
+
+    /**
+     * @brief Gets the statistics.
+     */
+    UploadQueueStats stats() const;
+
+    UploadQueue& operator=(UploadQueue&& other) = delete;
+    UploadQueue& operator=(const UploadQueue& other) = delete;
+};
+
+}
+
+#endif
@@ -2,6 +2,8 @@
 #define GLA_VERTEX_ARRAY_H
 
 #include <vector>
+#include <span>
+#include <string>
 #include <stdexcept>
 
 #include <GLA/buffer.h>
@@ -19,7 +21,10 @@ enum class VertexAttribType {
     HalfFloat,      ///< GL_HALF_FLOAT
     Float,          ///< GL_FLOAT
     Double,         ///< GL_DOUBLE
-    Fixed           ///< GL_FIXED
+    Fixed,          ///< GL_FIXED
+    Int2101010Rev,          ///< GL_INT_2_10_10_10_REV, 4 signed components packed into 32 bits (w in the top 2 bits)
+    UnsignedInt2101010Rev,  ///< GL_UNSIGNED_INT_2_10_10_10_REV, 4 unsigned components packed into 32 bits (w in the top 2 bits)
+    UnsignedInt10F11F11FRev ///< GL_UNSIGNED_INT_10F_11F_11F_REV, 3 unsigned floats packed into 32 bits
 };
 
 enum class VertexAttribInterp {
@@ -38,18 +43,83 @@ unsigned int toGLenum(VertexAttribType type);
 /**
  * @brief Checks if the type and interpretation combination is valid.
  * 
+ * @note constexpr, so it is also used by gla::staticVertexLayout at compile time.
+ * 
  * @param error The error string output
  * 
  * @returns true if it is valid, false otherwise
  */
-bool validateTypeInterpretation(VertexAttribType type, VertexAttribInterp interp, std::string& error);
+constexpr bool validateTypeInterpretation(VertexAttribType type, VertexAttribInterp interp, std::string& error) {
+    if (interp == VertexAttribInterp::Integer) {
+        switch (type) {
+        case VertexAttribType::HalfFloat: error = "Can't use type HalfFloat with Integer interpretation!"; return false;
+        case VertexAttribType::Float: error = "Can't use type Float with Integer interpretation!"; return false;
+        case VertexAttribType::Double: error = "Can't use type Double with Integer interpretation!"; return false;
+        case VertexAttribType::Fixed: error = "Can't use type Fixed with Integer interpretation!"; return false;
+        case VertexAttribType::Int2101010Rev: error = "Can't use type Int2101010Rev with Integer interpretation!"; return false;
+        case VertexAttribType::UnsignedInt2101010Rev: error = "Can't use type UnsignedInt2101010Rev with Integer interpretation!"; return false;
+        case VertexAttribType::UnsignedInt10F11F11FRev: error = "Can't use type UnsignedInt10F11F11FRev with Integer interpretation!"; return false;
+        default: break;
+        }
+    }
+    return true;
+}
 
 /**
  * @brief Gets the size of the given type in bytes.
  * 
  * @throws std::invalid_argument If the given VertexAttribType is invalid
+ * 
+ * @note Packed types return the size of the whole attribute, see attributeBytes.
  */
-int typeToBytes(VertexAttribType type);
+constexpr int typeToBytes(VertexAttribType type) {
+    switch (type)
+    {
+    case VertexAttribType::Byte:            return 1;
+    case VertexAttribType::UnsignedByte:    return 1;
+    case VertexAttribType::Short:           return 2;
+    case VertexAttribType::UnsignedShort:   return 2;
+    case VertexAttribType::Int:             return 4;
+    case VertexAttribType::UnsignedInt:     return 4;
+    case VertexAttribType::HalfFloat:       return 2;
+    case VertexAttribType::Float:           return 4;
+    case VertexAttribType::Double:          return 8;
+    case VertexAttribType::Fixed:           return 4;
+    case VertexAttribType::Int2101010Rev:           return 4;
+    case VertexAttribType::UnsignedInt2101010Rev:   return 4;
+    case VertexAttribType::UnsignedInt10F11F11FRev: return 4;
+    }
+    throw std::invalid_argument("Given VertexAttribType is invalid!");
+}
+
+/**
+ * @brief Checks if all components of the type are packed into one 32 bit value.
+ */
+constexpr bool isPackedType(VertexAttribType type) {
+    return type == VertexAttribType::Int2101010Rev || type == VertexAttribType::UnsignedInt2101010Rev || type == VertexAttribType::UnsignedInt10F11F11FRev;
+}
+
+/**
+ * @brief Checks if the type and number of components combination is valid.
+ * 
+ * Packed 2_10_10_10 types need 4 components and 10F_11F_11F needs 3, all other types take 1 to 4.
+ */
+constexpr bool validateTypeComponents(VertexAttribType type, int numComponents) {
+    if (type == VertexAttribType::Int2101010Rev || type == VertexAttribType::UnsignedInt2101010Rev)
+        return numComponents == 4;
+    if (type == VertexAttribType::UnsignedInt10F11F11FRev)
+        return numComponents == 3;
+    return numComponents >= 1 && numComponents <= 4;
+}
+
+/**
+ * @brief Gets the size of an attribute with the given type and number of components in bytes.
+ * 
+ * @throws std::invalid_argument If the given VertexAttribType is invalid
+ */
+constexpr int attributeBytes(VertexAttribType type, int numComponents) {
+    return isPackedType(type) ? typeToBytes(type) : typeToBytes(type) * numComponents;
+}
 
 /**
  * @brief Defines a vertex attribute for the gla::VertexArray.
@@ -63,6 +133,26 @@ struct VertexAttribute {
     int offset; ///< Offset to the start of the current VertexAttribute
 };
 
+template <typename Vertex, size_t N>
+struct StaticVertexLayout;
+
+/**
+ * @brief Validates a list of interleaved VertexAttributes sharing one stride.
+ * 
+ * @throws std::invalid_argument If stride is less than or equal to 0
+ * @throws std::runtime_error If the current GPU doesn't support the given amount of VertexAttribute (at least 16 are guaranteed)
+ * @throws std::invalid_argument If any offset is negative
+ * @throws std::invalid_argument If the any given index goes above the amount of VertexAttributes supported by the GPU (at least 16 are guaranteed)
+ * @throws std::invalid_argument If any VertexAttribute requests less than 1 or more than 4 numComponents
+ * @throws std::invalid_argument If any of the given combinations of type and interpretation is invalid
+ * 
+ * @throws std::invalid_argument If the given VertexAttributes extend over the given stride (only when DEBUG_MODE is defined)
+ * @throws std::invalid_argument If the given VertexAttributes overlap (only when DEBUG_MODE is defined)
+ * 
+ * @note The attribute limit is taken from gla::Capabilities, so no OpenGL query is issued.
+ */
+void validateVertexAttributes(const std::vector<VertexAttribute>& attribs, int stride);
+
 /**
  * @brief VertexArray class to abstract the OpenGL vertex array.
  * 
@@ -70,11 +160,14 @@ struct VertexAttribute {
  * @warning This class is not guaranteed to be thread-safe.
  * 
  * @note Inherits from gla::Buffer.
+ * @note Attributes are respecified on every setAttributes call, gla::VertexArrayObject records them once instead.
  */
 class VertexArray : public Buffer {
 private:
     std::vector<unsigned int> _enabledVertexAttribs = {};
 
+    void _setAttributes(std::span<const VertexAttribute> attribs, int stride);
+
 public:
     VertexArray() : Buffer(BufferType::Array) {}
     VertexArray(VertexArray&& other) : Buffer(std::move(other)) {}
@@ -84,7 +177,6 @@ public:
      * @brief Set the Attributes for a vertex array.
      * 
      * @throws std::invalid_argument If stride is less than or equal to 0
-     * @throws std::runtime_error If it could not query GL_MAX_VERTEX_ATTRIBS
      * @throws std::runtime_error If the current GPU doesn't support the given amount of VertexAttribute (at least 16 are guaranteed)
      * @throws std::invalid_argument If the any given index goes above the amount of VertexAttributes supported by the GPU (at least 16 are guaranteed)
      * @throws std::invalid_argument If any VertexAttribute requests less than 1 or more than 4 numComponents
@@ -100,6 +192,16 @@ public:
      */
     void setAttributes(const std::vector<VertexAttribute>& attribs, int stride);
 
+    /**
+     * @brief Set the Attributes for a vertex array from a layout validated at compile time, see gla::staticVertexLayout.
+     * 
+     * @note Calling this function binds this Buffer.
+     * 
+     * @param layout The layout of the vertex struct
+     */
+    template <typename Vertex, size_t N>
+    void setAttributes(const StaticVertexLayout<Vertex, N>& layout) { _setAttributes(layout.attributes, layout.stride); }
+
     VertexArray& operator=(VertexArray&& other) { Buffer::operator=(std::move(other)); return *this; }
     VertexArray& operator=(const VertexArray& other) = delete;
 };
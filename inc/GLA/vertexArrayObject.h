@@ -0,0 +1,143 @@
+#ifndef GLA_VERTEX_ARRAY_OBJECT_H
+#define GLA_VERTEX_ARRAY_OBJECT_H
+
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <GLA/buffer.h>
+#include <GLA/vertexArray.h>
+#include <GLA/vertexLayout.h>
+
+namespace gla {
+
+class DeletionQueue;
+
+/**
+ * @brief VertexArrayObject class to abstract OpenGL vertex array objects.
+ *
+ * Records the vertex Buffers, the element Buffer and the attribute layout once, so switching between meshes
+ * is a single bind() instead of respecifying every attribute before each draw.
+ *
+ * @warning VertexArrayObject must be deconstructed before the OpenGL context is destroyed.
+ * @warning This class is not guaranteed to be thread-safe.
+ * @warning The recorded Buffers must outlive their use through the VertexArrayObject.
+ * @warning Vertex array objects are never shared between contexts, only bind it in the context it was created in.
+ *
+ * @note When Capabilities::directStateAccess is available, recording never changes any binding state.
+ *       Otherwise it binds the VertexArrayObject and the vertex Buffer.
+ * @note The OpenGL object is released through the gla::DeletionQueue of the context it was created in upon destruction,
+ *       so the deletion runs in that context even if the VertexArrayObject is destroyed on another thread.
+ */
+class VertexArrayObject {
+protected:
+    unsigned int _id = 0;
+    DeletionQueue* _deletionQueue = nullptr; // of the context the vertex array object was created in
+    std::vector<int> _strides = {}; // of the VertexLayout, indexed by binding
+
+    void _delete();
+    void _check();
+    int _stride(unsigned int binding) const;
+    void _setVertexBuffer(const Buffer& buffer, std::span<const VertexAttribute> attribs, int stride, int64_t offset, unsigned int binding);
+
+public:
+    /**
+     * @brief Construct a new VertexArrayObject without any attributes.
+     *
+     * @throws std::runtime_error If the vertex array object could not be created
+     */
+    VertexArrayObject();
+    VertexArrayObject(VertexArrayObject&& other);
+    VertexArrayObject(const VertexArrayObject& other) = delete;
+    ~VertexArrayObject() noexcept;
+
+    /**
+     * @brief Binds the VertexArrayObject, which restores all recorded attributes and the element Buffer.
+     *
+     * @throws std::logic_error If the context it was created in is not current (debug builds only)
+     */
+    void bind() const;
+
+    /**
+     * @brief Records interleaved attributes sourced from a Buffer.
+     *
+     * Attributes of earlier calls at other indices stay enabled, so several Buffers can feed one VertexArrayObject.
+     *
+     * @throws std::invalid_argument If offset is negative
+     * @throws std::invalid_argument If the attributes are invalid, see gla::validateVertexAttributes
+     *
+     * @param buffer The Buffer holding the vertices
+     * @param attribs The attributes, with offsets relative to the start of a vertex
+     * @param stride The distance between two vertices in bytes
+     * @param offset The offset of the first vertex in the Buffer in bytes
+     * @param binding The vertex buffer binding index used with Capabilities::directStateAccess, one per Buffer
+     */
+    void setVertexBuffer(const Buffer& buffer, const std::vector<VertexAttribute>& attribs, int stride, int64_t offset = 0, unsigned int binding = 0);
+
+    /**
+     * @brief Records attributes of a layout validated at compile time sourced from a Buffer, see gla::staticVertexLayout.
+     *
+     * @throws std::invalid_argument If offset is negative
+     *
+     * @param buffer The Buffer holding the vertices
+     * @param layout The layout of the vertex struct
+     * @param offset The offset of the first vertex in the Buffer in bytes
+     * @param binding The vertex buffer binding index used with Capabilities::directStateAccess, one per Buffer
+     */
+    template <typename Vertex, size_t N>
+    void setVertexBuffer(const Buffer& buffer, const StaticVertexLayout<Vertex, N>& layout, int64_t offset = 0, unsigned int binding = 0) {
+        if (offset < 0)
+            throw std::invalid_argument("offset may not be negative!");
+        _setVertexBuffer(buffer, layout.attributes, layout.stride, offset, binding);
+    }
+
+    /**
+     * @brief Records the Buffer indexed draws read their indices from.
+     *
+     * @param buffer The Buffer holding the indices
+     */
+    void setElementBuffer(const Buffer& buffer);
+
+    /**
+     * @brief Applies a VertexLayout with glVertexAttribFormat / glVertexAttribBinding, the Buffers are bound per stream afterwards.
+     *
+     * @throws std::runtime_error If Capabilities::vertexAttribBinding is not available
+     *
+     * @note Attributes that are not part of the layout keep their state.
+     *
+     * @param layout The layout, its strides are remembered for bindVertexBuffer
+     */
+    void setLayout(const VertexLayout& layout);
+
+    /**
+     * @brief Sources a stream of the VertexLayout from a Buffer with a single glBindVertexBuffer.
+     *
+     * @throws std::logic_error If the binding is not a stream of the last VertexLayout set with setLayout
+     * @throws std::invalid_argument If offset is negative
+     *
+     * @param binding The binding index of the stream
+     * @param buffer The Buffer holding the vertices of the stream
+     * @param offset The offset of the first vertex in the Buffer in bytes
+     */
+    void bindVertexBuffer(unsigned int binding, const Buffer& buffer, int64_t offset = 0);
+
+    /**
+     * @brief Sources consecutive streams of the VertexLayout from Buffer ranges, with one glBindVertexBuffers call if Capabilities::multiBind is available.
+     *
+     * @throws std::logic_error If a binding is not a stream of the last VertexLayout set with setLayout
+     * @throws std::logic_error If a slice does not refer to a Buffer
+     * @throws std::invalid_argument If an offset is negative
+     *
+     * @param first The binding index of the first stream
+     * @param slices The ranges holding the vertices, slice i sources stream first + i (only buffer and offset are used)
+     */
+    void bindVertexBuffers(unsigned int first, std::span<const BufferSlice> slices);
+
+    VertexArrayObject& operator=(VertexArrayObject&& other);
+    VertexArrayObject& operator=(const VertexArrayObject& other) = delete;
+};
+
+}
+
+#endif
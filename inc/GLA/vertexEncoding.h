@@ -0,0 +1,125 @@
+#ifndef GLA_VERTEX_ENCODING_H
+#define GLA_VERTEX_ENCODING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include <glm/gtc/type_precision.hpp>
+
+#include <GLA/staticVertexLayout.h>
+
+namespace gla {
+
+/**
+ * @brief 16 bit float for VertexAttribType::HalfFloat attributes.
+ */
+struct Half {
+    uint16_t bits = 0;
+};
+
+/**
+ * @brief Four signed normalized components packed as VertexAttribType::Int2101010Rev (x in the low bits).
+ */
+struct PackedSnorm2101010 {
+    uint32_t bits = 0;
+};
+
+/**
+ * @brief Four unsigned normalized components packed as VertexAttribType::UnsignedInt2101010Rev (x in the low bits).
+ */
+struct PackedUnorm2101010 {
+    uint32_t bits = 0;
+};
+
+/**
+ * @brief Three unsigned floats packed as VertexAttribType::UnsignedInt10F11F11FRev (x in the low bits).
+ */
+struct PackedUfloat111110 {
+    uint32_t bits = 0;
+};
+
+template <> struct VertexScalarTraits<Half> { static constexpr bool supported = true; static constexpr VertexAttribType type = VertexAttribType::HalfFloat; static constexpr VertexAttribInterp interp = VertexAttribInterp::Float; };
+
+template <> struct VertexAttribTraits<PackedSnorm2101010> { static constexpr bool supported = true; static constexpr VertexAttribType type = VertexAttribType::Int2101010Rev;           static constexpr VertexAttribInterp interp = VertexAttribInterp::Float; static constexpr int components = 4; };
+template <> struct VertexAttribTraits<PackedUnorm2101010> { static constexpr bool supported = true; static constexpr VertexAttribType type = VertexAttribType::UnsignedInt2101010Rev;   static constexpr VertexAttribInterp interp = VertexAttribInterp::Float; static constexpr int components = 4; };
+template <> struct VertexAttribTraits<PackedUfloat111110> { static constexpr bool supported = true; static constexpr VertexAttribType type = VertexAttribType::UnsignedInt10F11F11FRev; static constexpr VertexAttribInterp interp = VertexAttribInterp::Float; static constexpr int components = 3; };
+
+/**
+ * @brief Quantization error of one encoded stream, measured by decoding the output again.
+ */
+struct EncodeReport {
+    size_t count = 0;       ///< Number of encoded elements.
+    float maxError = 0.0f;  ///< Largest absolute error of any component.
+    double meanError = 0.0; ///< Mean absolute error over all components.
+};
+
+/**
+ * @brief Encodes floats as half floats.
+ *
+ * @throws std::invalid_argument If dst and src differ in size
+ *
+ * @note Uses F16C when compiled with it (-mf16c or /arch:AVX2).
+ */
+EncodeReport encodeHalf(std::span<const float> src, std::span<Half> dst);
+
+/**
+ * @brief Encodes floats in [-1;1] as signed normalized 16 bit integers, read with normalized Short attributes.
+ *
+ * @throws std::invalid_argument If dst and src differ in size
+ *
+ * @note Values outside of [-1;1] are clamped. Uses AVX2 or SSE4.1 when compiled with it.
+ */
+EncodeReport encodeSnorm16(std::span<const float> src, std::span<int16_t> dst);
+
+/**
+ * @brief Encodes floats in [0;1] as unsigned normalized 16 bit integers, read with normalized UnsignedShort attributes.
+ *
+ * @throws std::invalid_argument If dst and src differ in size
+ *
+ * @note Values outside of [0;1] are clamped. Uses AVX2 or SSE4.1 when compiled with it.
+ */
+EncodeReport encodeUnorm16(std::span<const float> src, std::span<uint16_t> dst);
+
+/**
+ * @brief Encodes unit vectors with the octahedral mapping into two signed normalized 16 bit integers.
+ *
+ * The shader unfolds e with n = vec3(e, 1 - |e.x| - |e.y|), t = max(-n.z, 0), n.xy -= sign(n.xy) * t and normalizes n.
+ *
+ * @throws std::invalid_argument If dst and src differ in size
+ *
+ * @note The error is measured against the normalized input.
+ */
+EncodeReport encodeOctahedral(std::span<const glm::vec3> src, std::span<glm::i16vec2> dst);
+
+/**
+ * @brief Encodes vectors in [-1;1] (for example tangents with the handedness in w) as Int2101010Rev.
+ *
+ * @throws std::invalid_argument If dst and src differ in size
+ *
+ * @note Values are clamped, w is quantized to -1, 0 or 1. Uses SSE4.1 when compiled with it.
+ */
+EncodeReport encodeSnorm2101010(std::span<const glm::vec4> src, std::span<PackedSnorm2101010> dst);
+
+/**
+ * @brief Encodes vectors in [0;1] as UnsignedInt2101010Rev.
+ *
+ * @throws std::invalid_argument If dst and src differ in size
+ *
+ * @note Values are clamped, w is quantized to 2 bits. Uses SSE4.1 when compiled with it.
+ */
+EncodeReport encodeUnorm2101010(std::span<const glm::vec4> src, std::span<PackedUnorm2101010> dst);
+
+/**
+ * @brief Encodes non-negative vectors (for example colors) as UnsignedInt10F11F11FRev.
+ *
+ * @throws std::invalid_argument If dst and src differ in size
+ */
+EncodeReport encodeUfloat111110(std::span<const glm::vec3> src, std::span<PackedUfloat111110> dst);
+
+}
+
+#endif
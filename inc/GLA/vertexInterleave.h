@@ -0,0 +1,91 @@
+#ifndef GLA_VERTEX_INTERLEAVE_H
+#define GLA_VERTEX_INTERLEAVE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+
+#include <GLA/buffer.h>
+#include <GLA/staticVertexLayout.h>
+#include <GLA/vertexArray.h>
+
+namespace gla {
+
+/**
+ * @brief Interleaves separate attribute streams (SoA) into vertices (AoS).
+ *
+ * Stream i holds count tightly packed elements of attribs[i], for example glm::vec3 positions. The vertices are
+ * assembled in blocks that fit into the L1 cache and written out sequentially with non-temporal stores where
+ * available, so writing into write-combined mapped Buffer memory never reads it and always fills whole cache lines.
+ * Bytes of the stride not covered by an attribute are written as zero. 12 and 16 byte attributes (vec3, vec4) are
+ * moved by SSE2 kernels (AVX if enabled), in both directions.
+ *
+ * @throws std::invalid_argument If stride is not greater than 0
+ * @throws std::invalid_argument If there is not exactly one stream per attribute
+ * @throws std::invalid_argument If an attribute extends over the stride
+ *
+ * @param attribs The attributes, with offsets relative to the start of a vertex
+ * @param stride The distance between two vertices in bytes
+ * @param streams One source stream per attribute
+ * @param count The number of vertices
+ * @param dst The vertices (must have count * stride bytes)
+ */
+void interleaveVertices(std::span<const VertexAttribute> attribs, int stride, std::span<const void* const> streams, size_t count, void* dst);
+
+/**
+ * @brief Splits vertices (AoS) into separate attribute streams (SoA), the opposite of interleaveVertices.
+ *
+ * Vertices are read sequentially in cache sized blocks, so reading mapped Buffer memory stays sequential.
+ *
+ * @throws std::invalid_argument If the layout is invalid, see interleaveVertices
+ *
+ * @param attribs The attributes, with offsets relative to the start of a vertex
+ * @param stride The distance between two vertices in bytes
+ * @param src The vertices (must have count * stride bytes)
+ * @param count The number of vertices
+ * @param streams One destination stream per attribute, each receives count tightly packed elements
+ */
+void deinterleaveVertices(std::span<const VertexAttribute> attribs, int stride, const void* src, size_t count, std::span<void* const> streams);
+
+/**
+ * @brief Interleaves attribute streams directly into a mapped range of a Buffer, see interleaveVertices.
+ *
+ * @throws std::invalid_argument If the layout is invalid, see interleaveVertices
+ * @throws std::runtime_error If the range can't be mapped for writing, see Buffer::map
+ *
+ * @param buffer The Buffer receiving the vertices
+ * @param offset The offset of the first vertex in the Buffer in bytes
+ */
+void interleaveVertices(Buffer& buffer, int64_t offset, std::span<const VertexAttribute> attribs, int stride, std::span<const void* const> streams, size_t count);
+
+/**
+ * @brief Splits the vertices of a mapped range of a Buffer into attribute streams, see deinterleaveVertices.
+ *
+ * @throws std::invalid_argument If the layout is invalid, see interleaveVertices
+ * @throws std::runtime_error If the range can't be mapped for reading, see Buffer::map
+ *
+ * @param buffer The Buffer holding the vertices
+ * @param offset The offset of the first vertex in the Buffer in bytes
+ */
+void deinterleaveVertices(Buffer& buffer, int64_t offset, std::span<const VertexAttribute> attribs, int stride, size_t count, std::span<void* const> streams);
+
+/**
+ * @brief Interleaves attribute streams into vertices of a layout validated at compile time, see interleaveVertices.
+ */
+template <typename Vertex, size_t N>
+void interleaveVertices(const StaticVertexLayout<Vertex, N>& layout, std::span<const void* const> streams, size_t count, Vertex* dst) {
+    interleaveVertices(layout.attributes, layout.stride, streams, count, dst);
+}
+
+/**
+ * @brief Splits vertices of a layout validated at compile time into attribute streams, see deinterleaveVertices.
+ */
+template <typename Vertex, size_t N>
+void deinterleaveVertices(const StaticVertexLayout<Vertex, N>& layout, const Vertex* src, size_t count, std::span<void* const> streams) {
+    deinterleaveVertices(layout.attributes, layout.stride, src, count, streams);
+}
+
+}
+
+#endif
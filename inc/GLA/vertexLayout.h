@@ -0,0 +1,94 @@
+#ifndef GLA_VERTEX_LAYOUT_H
+#define GLA_VERTEX_LAYOUT_H
+
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <GLA/vertexArray.h>
+
+namespace gla {
+
+/**
+ * @brief Vertex format separated from the Buffers the vertices live in (ARB_vertex_attrib_binding).
+ *
+ * A layout consists of streams, each identified by a binding index with its own stride and interleaved attributes.
+ * It is validated once on construction and applied with gla::VertexArrayObject::setLayout, afterwards changing the
+ * Buffer or offset of a stream is a single gla::VertexArrayObject::bindVertexBuffer.
+ *
+ * @note The layout only holds the format, so it can be shared by any number of meshes.
+ */
+class VertexLayout {
+protected:
+    struct _Attribute {
+        VertexAttribute attribute;
+        unsigned int binding;
+    };
+
+    std::vector<_Attribute> _attributes = {};
+    std::vector<int> _strides = {}; // indexed by binding, 0 for unused bindings
+
+    void _addStream(unsigned int binding, std::span<const VertexAttribute> attribs, int stride);
+
+public:
+    /**
+     * @brief Construct an empty VertexLayout, streams are added with addStream.
+     */
+    VertexLayout() = default;
+
+    /**
+     * @brief Construct a VertexLayout with one interleaved stream at binding 0.
+     *
+     * @throws std::invalid_argument If the attributes are invalid, see addStream
+     *
+     * @param attribs The attributes, with offsets relative to the start of a vertex
+     * @param stride The distance between two vertices in bytes
+     */
+    VertexLayout(const std::vector<VertexAttribute>& attribs, int stride);
+
+    /**
+     * @brief Construct a VertexLayout with one stream at binding 0 from a layout validated at compile time, see gla::staticVertexLayout.
+     */
+    template <typename Vertex, size_t N>
+    VertexLayout(const StaticVertexLayout<Vertex, N>& layout) { _addStream(0, layout.attributes, layout.stride); }
+
+    /**
+     * @brief Adds a stream of interleaved attributes read from its own vertex Buffer binding.
+     *
+     * @throws std::invalid_argument If binding is not below Capabilities::maxVertexAttribBindings
+     * @throws std::invalid_argument If binding is already used by another stream
+     * @throws std::invalid_argument If an attribute index is already used by another stream
+     * @throws std::invalid_argument If the attributes are invalid, see gla::validateVertexAttributes
+     *
+     * @param binding The vertex Buffer binding index of the stream
+     * @param attribs The attributes of the stream, with offsets relative to the start of a vertex in the stream
+     * @param stride The distance between two vertices of the stream in bytes
+     */
+    void addStream(unsigned int binding, const std::vector<VertexAttribute>& attribs, int stride);
+
+    /**
+     * @brief Adds a stream from a layout validated at compile time, see gla::staticVertexLayout.
+     *
+     * @throws std::invalid_argument If binding is invalid or an attribute index is already used, see addStream
+     */
+    template <typename Vertex, size_t N>
+    void addStream(unsigned int binding, const StaticVertexLayout<Vertex, N>& layout) { _addStream(binding, layout.attributes, layout.stride); }
+
+    /**
+     * @brief Gets the stride of a stream.
+     *
+     * @throws std::out_of_range If no stream uses the binding
+     */
+    int stride(unsigned int binding) const;
+
+    /**
+     * @brief Gets one past the highest binding index used by a stream.
+     */
+    unsigned int bindings() const { return static_cast<unsigned int>(_strides.size()); }
+
+    friend class VertexArrayObject;
+};
+
+}
+
+#endif
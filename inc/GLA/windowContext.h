@@ -1,8 +1,13 @@
 #ifndef GLA_WINDOW_CONTEXT
 #define GLA_WINDOW_CONTEXT
 
+#include <memory>
+
 #include <GLFW/glfw3.h>
 
+#include <GLA/deletionQueue.h>
+#include <GLA/stateCache.h>
+
 namespace gla {
 
 /**
@@ -42,6 +47,8 @@ void pollEvents();
 class WindowContext {
 private:
     bool _ownsGLFW = false;
+    StateCache _stateCache = {};
+    std::unique_ptr<DeletionQueue> _deletionQueue = std::make_unique<DeletionQueue>(); // heap allocated, objects keep pointing to it across moves
 
     static void _onResize(GLFWwindow* window, int width, int height);
     static void _onClose(GLFWwindow* window);
@@ -70,10 +77,22 @@ protected:
     /**
      * @brief Makes the owned window the current context.
      * 
+     * @note Also makes the StateCache and the DeletionQueue of this context the current ones of the calling thread.
+     * 
      * @throws std::runtime_error If the GLFW window is invalid.
      */
     void useContext();
 
+    /**
+     * @brief Gets the StateCache shadowing the binding state of this context.
+     */
+    StateCache& stateCache() { return _stateCache; }
+
+    /**
+     * @brief Gets the DeletionQueue releasing the objects created in this context.
+     */
+    DeletionQueue& deletionQueue() { return *_deletionQueue; }
+
     /**
      * @brief Checks if the Window should close.
      * 
@@ -84,6 +103,10 @@ protected:
     /**
      * @brief Swaps the display buffers.
      * 
+     * @note Also ends the frame of the gla::DeletionQueue of this context, deleting objects released in frames the GPU has finished.
+     * @note Also finishes the frame high-water mark of the gla::MemoryTracker, but only in one context (the first to swap its
+     *       buffers, until it is destroyed), so with several windows a frame is counted once per application frame.
+     * 
      * @throws std::runtime_error If the GLFW Window is invalid.
      */
     void swapBuffers();
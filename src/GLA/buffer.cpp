@@ -1,12 +1,30 @@
 #include <GLA/buffer.h>
 
 #include <GLA/debug.h>
+#include <GLA/capabilities.h>
+#include <GLA/deletionQueue.h>
+#include <GLA/memoryTracker.h>
+#include <GLA/fence.h>
+#include <GLA/readback.h>
+#include <GLA/stateCache.h>
 
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
 
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <numeric>
+#include <vector>
+
 namespace gla {
 
+namespace {
+    constexpr int64_t COMPACT_MIN_PIECE = 64 * 1024;        // smaller moves bounce through a scratch Buffer instead of being split
+    constexpr int64_t COMPACT_SCRATCH_SIZE = 1024 * 1024;   // upper bound of that scratch Buffer
+}
+
 unsigned int toGLenum(BufferType type) {
     switch (type)
     {
@@ -28,6 +46,11 @@ unsigned int toGLenum(BufferType type) {
     throw std::invalid_argument("BufferType is invalid!");
 }
 
+bool hasIndexedBindings(BufferType type) {
+    return type == BufferType::AtomicCounter || type == BufferType::ShaderStorage
+        || type == BufferType::TransformFeedback || type == BufferType::Uniform;
+}
+
 unsigned int toGLenum(BufferUsage usage) {
     switch (usage)
     {
@@ -73,6 +96,7 @@ unsigned int toGLenum(BufferFlag flag) {
     check(BufferFlag::MapPersistent, GL_MAP_PERSISTENT_BIT);
     check(BufferFlag::MapCoherent, GL_MAP_COHERENT_BIT);
     check(BufferFlag::ClientStorage, GL_CLIENT_STORAGE_BIT);
+    check(BufferFlag::Sparse, GL_SPARSE_STORAGE_BIT_ARB);
     return flags;
 }
 
@@ -109,26 +133,155 @@ bool validateBufferFlag(BufferFlag flag, std::string& error) {
         error = "BufferFlag::MapPersistent must be set when using BufferFlag::MapCoherent!";
         return false;
     }
+    if ((flag & BufferFlag::Sparse) != BufferFlag::None && (flag & (BufferFlag::MapRead | BufferFlag::MapWrite | BufferFlag::MapPersistent | BufferFlag::MapCoherent)) != BufferFlag::None) {
+        error = "BufferFlag::Sparse can't be combined with mapping flags!";
+        return false;
+    }
     return true;
 }
 
+int64_t compactBuffer(Buffer& buffer, std::span<BufferRecord> records, int64_t alignment) {
+    if (alignment <= 0)
+        throw std::invalid_argument("alignment must be greater than 0!");
+
+    std::vector<size_t> order(records.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return records[a].offset < records[b].offset; });
+
+    int64_t previousEnd = 0;
+    for (size_t i : order) {
+        const BufferRecord& record = records[i];
+        if (record.offset < 0 || record.size < 0 || record.offset + record.size > buffer.size())
+            throw std::invalid_argument("Record lies outside of the Buffer!");
+        if (record.offset % alignment != 0)
+            throw std::invalid_argument("Record offsets must be multiples of alignment!");
+        if (record.offset < previousEnd)
+            throw std::invalid_argument("Records may not overlap!");
+        previousEnd = record.offset + record.size;
+    }
+
+    // every record moves towards the start, so processing them in ascending order never overwrites a live record
+    std::vector<BufferCopyRegion> regions;
+    std::unique_ptr<Buffer> scratch;
+    int64_t end = 0;
+    for (size_t i : order) {
+        BufferRecord& record = records[i];
+        int64_t dst = (end + alignment - 1) / alignment * alignment;
+        int64_t distance = record.offset - dst;
+        if (distance > 0 && record.size > distance && distance < COMPACT_MIN_PIECE) {
+            // splitting into pieces of distance bytes would issue record.size / distance copies, bounce through scratch instead
+            int64_t scratchSize = std::min(COMPACT_SCRATCH_SIZE, record.size);
+            if (!scratch)
+                scratch = std::make_unique<Buffer>(BufferType::CopyWrite);
+            if (scratch->size() < scratchSize)
+                scratch->setData(scratchSize, nullptr, BufferUsage::StreamCopy);
+            // the copies are executed in order, so the moves queued so far have to be issued first
+            buffer.copyFrom(buffer, regions);
+            regions.clear();
+            for (int64_t moved = 0; moved < record.size; moved += scratch->size()) {
+                int64_t size = std::min(scratch->size(), record.size - moved);
+                scratch->copyFrom(buffer, record.offset + moved, 0, size);
+                buffer.copyFrom(*scratch, 0, dst + moved, size);
+            }
+        } else if (distance > 0 && record.size > 0) {
+            // pieces of at most distance bytes never overlap their destination
+            for (int64_t moved = 0; moved < record.size; moved += distance)
+                regions.push_back({ record.offset + moved, dst + moved, std::min(distance, record.size - moved) });
+        }
+        record.offset = dst;
+        end = dst + record.size;
+    }
+    buffer.copyFrom(buffer, regions);
+    return end;
+}
+
 // ----------------------------------------------------------------------------------------------------
 // class Buffer
 // ----------------------------------------------------------------------------------------------------
 
+#ifdef GLA_VALIDATE_SHADOW_STATE
+    #define VALIDATE_SHADOW() validateShadowState()
+#else
+    #define VALIDATE_SHADOW() ((void)0)
+#endif
+
 // --------------------------------------------------
 // protected methods
 // --------------------------------------------------
 
 void Buffer::_delete() {
-    if (_id != 0)
-        GL_CALL(glDeleteBuffers(1, &_id));
-    _id = 0; 
+    if (_id != 0) {
+        memoryTracker().bufferReleased(_type, _immutable, _usage, _flags, _size);
+        memoryTracker().objectDestroyed(TrackedObject::Buffer);
+        _deletionQueue->push(DeletionType::Buffer, _id);
+    }
+    _id = 0;
+    _size = 0;
+    _immutable = false;
+    _flags = BufferFlag::None;
+    _resetMapping();
 }
 
 void Buffer::_check() {
     if (_id == 0)
         throw std::runtime_error("Failed to create buffer object!");
+    _deletionQueue = &deletionQueue();
+    memoryTracker().objectCreated(TrackedObject::Buffer);
+}
+
+void Buffer::_resetMapping() {
+    _mapped = false;
+    _mapUsage = MapUsage::None;
+    _mapOffset = 0;
+    _mapLength = 0;
+    _mapPointer = nullptr;
+}
+
+void Buffer::_validateRange(int64_t offset, int64_t size) const {
+    if (offset < 0)
+        throw std::runtime_error("offset may not be negative!");
+    if (size < 0)
+        throw std::runtime_error("size may not be negative!");
+    if (size + offset > _size)
+        throw std::runtime_error("length + offset may not be greater than size()!");
+}
+
+void Buffer::_validateCopy(const Buffer& src, const BufferCopyRegion& region) const {
+    src._validateRange(region.srcOffset, region.size);
+    _validateRange(region.dstOffset, region.size);
+    if (&src == this && region.srcOffset < region.dstOffset + region.size && region.dstOffset < region.srcOffset + region.size)
+        throw std::runtime_error("Source and destination range of a copy within one Buffer may not overlap!");
+    if ((src._mapped && (src._mapUsage & MapUsage::Persistent) == MapUsage::None) || (_mapped && (_mapUsage & MapUsage::Persistent) == MapUsage::None))
+        throw std::runtime_error("copyFrom can't be used when a Buffer is mapped and MapUsage::Persistent is not set!");
+}
+
+void Buffer::_clear(int64_t offset, int64_t size, unsigned int internalFormat, unsigned int format, unsigned int type, const void* value, int64_t valueSize) {
+    if (size == -1 && offset >= 0 && offset <= _size)
+        size = _size - offset;
+    _validateRange(offset, size);
+    if (offset % valueSize != 0 || size % valueSize != 0)
+        throw std::runtime_error("offset and size must be multiples of the size of the fill value!");
+    if (_mapped && (_mapUsage & MapUsage::Persistent) == MapUsage::None)
+        throw std::runtime_error("fill can't be used when Buffer is mapped and MapUsage::Persistent is not set!");
+    if (size == 0)
+        return;
+    if (capabilities().directStateAccess) {
+        GL_CALL(glClearNamedBufferSubData(_id, internalFormat, offset, size, format, type, value));
+        return;
+    }
+    bind();
+    GL_CALL(glClearBufferSubData(toGLenum(_type), internalFormat, offset, size, format, type, value));
+}
+
+void Buffer::_copy(const Buffer& src, int64_t srcOffset, Buffer& dst, int64_t dstOffset, int64_t size) {
+    if (capabilities().directStateAccess) {
+        GL_CALL(glCopyNamedBufferSubData(src._id, dst._id, srcOffset, dstOffset, size));
+        return;
+    }
+    StateCache& cache = StateCache::current();
+    cache.bindBuffer(BufferType::CopyRead, src._id);
+    cache.bindBuffer(BufferType::CopyWrite, dst._id);
+    GL_CALL(glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, srcOffset, dstOffset, size));
 }
 
 // --------------------------------------------------
@@ -136,15 +289,21 @@ void Buffer::_check() {
 // --------------------------------------------------
 
 Buffer::Buffer(BufferType type) : _type(type) {
-    GL_CALL(glGenBuffers(1, &_id));
+    if (capabilities().directStateAccess)
+        GL_CALL(glCreateBuffers(1, &_id));
+    else
+        GL_CALL(glGenBuffers(1, &_id));
     _check();
 }
 Buffer::Buffer(Buffer&& other)
-    : _id(other._id), _mapped(other._mapped), _mapUsage(other._mapUsage), _type(other._type), _flags(other._flags) {
+    : _id(other._id), _type(other._type), _deletionQueue(other._deletionQueue), _size(other._size), _immutable(other._immutable), _usage(other._usage), _flags(other._flags),
+      _mapped(other._mapped), _mapUsage(other._mapUsage), _mapOffset(other._mapOffset), _mapLength(other._mapLength), _mapPointer(other._mapPointer),
+      _updatePolicy(other._updatePolicy) {
     other._id = 0;
-    other._mapUsage = MapUsage::None;
-    other._mapped = false;
+    other._size = 0;
+    other._immutable = false;
     other._flags = BufferFlag::None;
+    other._resetMapping();
 }
 Buffer::~Buffer() noexcept {
     _delete();
@@ -155,65 +314,311 @@ Buffer::~Buffer() noexcept {
 // --------------------------------------------------
 
 void Buffer::bind() const {
-    GL_CALL(glBindBuffer(toGLenum(_type), _id)); 
+    StateCache::current().bindBuffer(_type, _id);
 }
 
-int64_t Buffer::size() const {
-    bind();
-    GLint64 size = 0;
-    GL_CALL(glGetBufferParameteri64v(toGLenum(_type), GL_BUFFER_SIZE, &size));
-    return size;
+void Buffer::bindBase(unsigned int index) const {
+    if (!hasIndexedBindings(_type))
+        throw std::logic_error("BufferType has no indexed binding points!");
+    StateCache::current().bindBufferBase(_type, index, _id);
+}
+
+void Buffer::bindRange(unsigned int index, int64_t offset, int64_t size) const {
+    bindRange(_type, index, offset, size);
+}
+
+void Buffer::bindRange(BufferType type, unsigned int index, int64_t offset, int64_t size) const {
+    if (!hasIndexedBindings(type))
+        throw std::logic_error("BufferType has no indexed binding points!");
+    if (offset < 0)
+        throw std::runtime_error("offset may not be negative!");
+    if (size <= 0)
+        throw std::runtime_error("size must be greater than 0!");
+    if (size + offset > _size)
+        throw std::runtime_error("size + offset may not be greater than size()!");
+    StateCache::current().bindBufferRange(type, index, _id, offset, size);
+}
+
+void Buffer::bindRanges(BufferType type, unsigned int first, std::span<const BufferSlice> slices) {
+    if (!hasIndexedBindings(type))
+        throw std::logic_error("BufferType has no indexed binding points!");
+    std::vector<unsigned int> ids;
+    std::vector<int64_t> offsets;
+    std::vector<int64_t> sizes;
+    ids.reserve(slices.size());
+    offsets.reserve(slices.size());
+    sizes.reserve(slices.size());
+    for (const BufferSlice& slice : slices) {
+        if (!slice.valid())
+            throw std::logic_error("BufferSlice does not refer to a Buffer!");
+        if (slice.offset < 0 || slice.size <= 0 || slice.offset + slice.size > slice.buffer->_size)
+            throw std::runtime_error("BufferSlice is empty or outside of its Buffer!");
+        ids.push_back(slice.buffer->_id);
+        offsets.push_back(slice.offset);
+        sizes.push_back(slice.size);
+    }
+    StateCache::current().bindBuffersRange(type, first, ids, offsets, sizes);
 }
 
 BufferType Buffer::getType() const {
     return _type;
 }
 
+void Buffer::validateShadowState() const {
+    auto query = [&](GLenum pname) {
+        GLint64 value = 0;
+        if (capabilities().directStateAccess) {
+            GL_CALL(glGetNamedBufferParameteri64v(_id, pname, &value));
+        } else {
+            bind();
+            GL_CALL(glGetBufferParameteri64v(toGLenum(_type), pname, &value));
+        }
+        return value;
+    };
+    if (query(GL_BUFFER_SIZE) != _size)
+        throw std::logic_error("Buffer shadow state mismatch: size differs from GL_BUFFER_SIZE!");
+    if ((query(GL_BUFFER_IMMUTABLE_STORAGE) != GL_FALSE) != _immutable)
+        throw std::logic_error("Buffer shadow state mismatch: immutability differs from GL_BUFFER_IMMUTABLE_STORAGE!");
+    if (_immutable && query(GL_BUFFER_STORAGE_FLAGS) != toGLenum(_flags))
+        throw std::logic_error("Buffer shadow state mismatch: flags differ from GL_BUFFER_STORAGE_FLAGS!");
+    if (!_immutable && _size > 0 && query(GL_BUFFER_USAGE) != toGLenum(_usage))
+        throw std::logic_error("Buffer shadow state mismatch: usage differs from GL_BUFFER_USAGE!");
+    if ((query(GL_BUFFER_MAPPED) != GL_FALSE) != _mapped)
+        throw std::logic_error("Buffer shadow state mismatch: mapping state differs from GL_BUFFER_MAPPED!");
+    if (_mapped && (query(GL_BUFFER_MAP_OFFSET) != _mapOffset || query(GL_BUFFER_MAP_LENGTH) != _mapLength))
+        throw std::logic_error("Buffer shadow state mismatch: mapped range differs from GL_BUFFER_MAP_OFFSET / GL_BUFFER_MAP_LENGTH!");
+}
+
 void Buffer::setData(int64_t size, const void* data, BufferUsage usage) {
-    bind();
     if (size < 0)
         throw std::runtime_error("size may not be negative!");
+    if (_immutable)
+        throw std::runtime_error("setData can't be used on immutable storage allocated with setStorage!");
+    if (capabilities().directStateAccess) {
+        GL_CALL(glNamedBufferData(_id, size, data, toGLenum(usage)));
+    } else {
+        bind();
+        GL_CALL(glBufferData(toGLenum(_type), size, data, toGLenum(usage)));
+    }
+    memoryTracker().bufferReleased(_type, false, _usage, BufferFlag::None, _size);
+    memoryTracker().bufferAllocated(_type, false, usage, BufferFlag::None, size);
+    _size = size;
+    _usage = usage;
     _flags = BufferFlag::None;
-    GL_CALL(glBufferData(toGLenum(_type), size, data, toGLenum(usage)));
+    _resetMapping(); // re-specifying the data store implicitly unmaps it
+    VALIDATE_SHADOW();
 }
 
 void Buffer::setStorage(int64_t size, const void* data, BufferFlag flags) {
-    bind();
     if (size <= 0)
         throw std::runtime_error("size must be greater than 0!");
+    if (_immutable)
+        throw std::runtime_error("setStorage can't be used on storage that is already immutable!");
     std::string error;
     if (!validateBufferFlag(flags, error))
         throw std::runtime_error("Invalid Buffer Flags:\n" + error);
+    if ((flags & BufferFlag::Sparse) != BufferFlag::None) {
+        if (!capabilities().sparseBuffer)
+            throw std::runtime_error("BufferFlag::Sparse requires ARB_sparse_buffer!");
+        if (data != nullptr)
+            throw std::runtime_error("Sparse storage can't be initialized with data!");
+    }
+    if (capabilities().directStateAccess) {
+        GL_CALL(glNamedBufferStorage(_id, size, data, toGLenum(flags)));
+    } else {
+        bind();
+        GL_CALL(glBufferStorage(toGLenum(_type), size, data, toGLenum(flags)));
+    }
+    memoryTracker().bufferReleased(_type, false, _usage, BufferFlag::None, _size);
+    memoryTracker().bufferAllocated(_type, true, _usage, flags, size);
+    _size = size;
+    _immutable = true;
     _flags = flags;
-    GL_CALL(glBufferStorage(toGLenum(_type), size, data, toGLenum(flags)));
+    _resetMapping();
+    VALIDATE_SHADOW();
+}
+
+void Buffer::commitPages(int64_t offset, int64_t size, bool commit) {
+    if ((_flags & BufferFlag::Sparse) == BufferFlag::None)
+        throw std::logic_error("commitPages requires BufferFlag::Sparse to be set through setStorage!");
+    _validateRange(offset, size);
+    int64_t pageSize = capabilities().sparseBufferPageSize;
+    if (offset % pageSize != 0 || (size % pageSize != 0 && offset + size != _size))
+        throw std::runtime_error("offset and size must be multiples of the sparse page size!");
+    bind(); // ARB_sparse_buffer has no direct state access entry point in GLEW
+    GL_CALL(glBufferPageCommitmentARB(toGLenum(_type), offset, size, commit ? GL_TRUE : GL_FALSE));
 }
 
 void Buffer::setSubData(int64_t offset, int64_t size, const void* data) {
-    if (offset < 0)
-        throw std::runtime_error("offset may not be negative!");
-    if (size < 0)
-        throw std::runtime_error("size may not be negative!");
-    if (size + offset > Buffer::size())
-        throw std::runtime_error("length + offset may not be greater than size()!");
+    _validateRange(offset, size);
     if (_mapped && (_mapUsage & MapUsage::Persistent) == MapUsage::None)
         throw std::runtime_error("setSubData can't be used when Buffer is mapped and MapUsage::Persistent is not set!");
+    bool whole = offset == 0 && size == _size;
+    switch (_updatePolicy)
+    {
+    case UpdatePolicy::SubData:
+        break;
+    case UpdatePolicy::Orphan:
+        if (_immutable)
+            throw std::runtime_error("UpdatePolicy::Orphan can't be used on immutable storage allocated with setStorage!");
+        if (whole && !_mapped) {
+            setData(size, data, _usage);
+            return;
+        }
+        break;
+    case UpdatePolicy::Invalidate:
+        if (!capabilities().invalidateSubdata || size == 0)
+            break;
+        if (whole)
+            GL_CALL(glInvalidateBufferData(_id));
+        else
+            GL_CALL(glInvalidateBufferSubData(_id, offset, size));
+        break;
+    case UpdatePolicy::MapInvalidate:
+        if (_mapped)
+            throw std::runtime_error("UpdatePolicy::MapInvalidate can't be used when Buffer is mapped!");
+        if (size == 0)
+            return;
+        {
+            MapUsage access = MapUsage::Write | (whole ? MapUsage::InvalidateBuffer | MapUsage::Unsynchronized : MapUsage::InvalidRange);
+            std::memcpy(map(offset, size, access), data, size);
+            unmap();
+        }
+        return;
+    }
+    if (_immutable && (_flags & BufferFlag::DynamicStorage) == BufferFlag::None)
+        throw std::runtime_error("setSubData requires BufferFlag::DynamicStorage to be set through setStorage!");
+    if (capabilities().directStateAccess) {
+        GL_CALL(glNamedBufferSubData(_id, offset, size, data));
+        return;
+    }
     bind();
     GL_CALL(glBufferSubData(toGLenum(_type), offset, size, data));
 }
 
 void Buffer::getSubData(int64_t offset, int64_t size, void* data) {
-    if (offset < 0)
-        throw std::runtime_error("offset may not be negative!");
-    if (size < 0)
-        throw std::runtime_error("size may not be negative!");
-    if (size + offset > Buffer::size())
-        throw std::runtime_error("length + offset may not be greater than size()!");
+    _validateRange(offset, size);
     if (_mapped && (_mapUsage & MapUsage::Persistent) == MapUsage::None)
         throw std::runtime_error("getSubData can't be used when Buffer is mapped and MapUsage::Persistent is not set!");
+    if (capabilities().directStateAccess) {
+        GL_CALL(glGetNamedBufferSubData(_id, offset, size, data));
+        return;
+    }
     bind();
     GL_CALL(glGetBufferSubData(toGLenum(_type), offset, size, data));
 }
 
+Readback Buffer::readAsync(int64_t offset, int64_t size, ReadbackQueue& queue) const {
+    _validateRange(offset, size);
+    if (size == 0)
+        throw std::runtime_error("size must be greater than 0!");
+    if (_mapped && (_mapUsage & MapUsage::Persistent) == MapUsage::None)
+        throw std::runtime_error("readAsync can't be used when Buffer is mapped and MapUsage::Persistent is not set!");
+    int64_t begin;
+    int64_t stagingOffset = queue._reserve(size, begin);
+    _copy(*this, offset, queue._staging, stagingOffset, size);
+    return queue._submit(begin, stagingOffset, size);
+}
+
+FileLoadStats Buffer::loadFromFile(const std::string& path, int64_t fileOffset, int64_t length, int64_t dstOffset, const FileLoadOptions& options) {
+    if (options.chunkSize <= 0 || options.chunksInFlight == 0 || options.windowSize < options.chunkSize)
+        throw std::invalid_argument("FileLoadOptions are invalid, windowSize must be at least chunkSize!");
+    auto start = std::chrono::steady_clock::now();
+
+    FileMapping file(path);
+    if (fileOffset < 0 || fileOffset > file.size())
+        throw std::runtime_error("fileOffset is outside of the file!");
+    if (length == -1)
+        length = file.size() - fileOffset;
+    if (length < 0 || fileOffset + length > file.size())
+        throw std::runtime_error("length + fileOffset may not be greater than the size of the file!");
+    if (_size == 0 && !_immutable)
+        setData(dstOffset + length, nullptr, BufferUsage::StaticDraw);
+    _validateRange(dstOffset, length);
+    if (_mapped && (_mapUsage & MapUsage::Persistent) == MapUsage::None)
+        throw std::runtime_error("loadFromFile can't be used when Buffer is mapped and MapUsage::Persistent is not set!");
+
+    FileLoadStats stats;
+    if (length == 0)
+        return stats;
+
+    int64_t chunkSize = std::min(options.chunkSize, length);
+    uint32_t slots = static_cast<uint32_t>(std::min<int64_t>(options.chunksInFlight, (length + chunkSize - 1) / chunkSize));
+    Buffer staging(BufferType::CopyRead);
+    staging.setStorage(chunkSize * slots, nullptr, BufferFlag::MapWrite | BufferFlag::MapPersistent | BufferFlag::MapCoherent);
+    char* data = static_cast<char*>(staging.map(0, chunkSize * slots, MapUsage::Write | MapUsage::Persistent | MapUsage::Coherent));
+    std::vector<Fence> fences(slots);
+
+    const char* window = nullptr;
+    for (int64_t position = 0; position < length; position += chunkSize) {
+        int64_t size = std::min(chunkSize, length - position);
+        int64_t fileStart = fileOffset + position;
+        if (window == nullptr || fileStart + size > file.windowOffset() + file.windowLength()) {
+            window = file.map(fileStart, std::min(options.windowSize, fileOffset + length - fileStart));
+            stats.windows++;
+        }
+
+        uint32_t slot = stats.chunks % slots;
+        if (!fences[slot].signaled()) {
+            fences[slot].wait();
+            stats.stalls++;
+        }
+        std::memcpy(data + slot * chunkSize, window + (fileStart - file.windowOffset()), size);
+        _copy(staging, slot * chunkSize, *this, dstOffset + position, size);
+        fences[slot].insert();
+        stats.chunks++;
+    }
+    for (Fence& fence : fences)
+        fence.wait();
+
+    stats.bytes = length;
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return stats;
+}
+
+void Buffer::copyFrom(const Buffer& src, int64_t srcOffset, int64_t dstOffset, int64_t size) {
+    _validateCopy(src, { srcOffset, dstOffset, size });
+    if (size > 0)
+        _copy(src, srcOffset, *this, dstOffset, size);
+}
+
+void Buffer::copyFrom(const Buffer& src, std::span<const BufferCopyRegion> regions) {
+    for (const BufferCopyRegion& region : regions)
+        _validateCopy(src, region);
+    if (capabilities().directStateAccess) {
+        for (const BufferCopyRegion& region : regions)
+            if (region.size > 0)
+                GL_CALL(glCopyNamedBufferSubData(src._id, _id, region.srcOffset, region.dstOffset, region.size));
+        return;
+    }
+    StateCache& cache = StateCache::current();
+    cache.bindBuffer(BufferType::CopyRead, src._id);
+    cache.bindBuffer(BufferType::CopyWrite, _id);
+    for (const BufferCopyRegion& region : regions)
+        if (region.size > 0)
+            GL_CALL(glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, region.srcOffset, region.dstOffset, region.size));
+}
+
+void Buffer::fill(uint8_t value, int64_t offset, int64_t size) {
+    _clear(offset, size, GL_R8UI, GL_RED_INTEGER, GL_UNSIGNED_BYTE, &value, sizeof(value));
+}
+
+void Buffer::fill(uint16_t value, int64_t offset, int64_t size) {
+    _clear(offset, size, GL_R16UI, GL_RED_INTEGER, GL_UNSIGNED_SHORT, &value, sizeof(value));
+}
+
+void Buffer::fill(uint32_t value, int64_t offset, int64_t size) {
+    _clear(offset, size, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, &value, sizeof(value));
+}
+
+void Buffer::fill(int32_t value, int64_t offset, int64_t size) {
+    _clear(offset, size, GL_R32I, GL_RED_INTEGER, GL_INT, &value, sizeof(value));
+}
+
+void Buffer::fill(float value, int64_t offset, int64_t size) {
+    _clear(offset, size, GL_R32F, GL_RED, GL_FLOAT, &value, sizeof(value));
+}
+
 void* Buffer::map(int64_t offset, int64_t length, MapUsage access) {
     if (_mapped)
         throw std::runtime_error("Buffer is already mapped!");
@@ -221,33 +626,65 @@ void* Buffer::map(int64_t offset, int64_t length, MapUsage access) {
         throw std::runtime_error("length must be greater than 0!");
     if (offset < 0)
         throw std::runtime_error("offset may not be negative!");
-    if (length + offset > size())
+    if (length + offset > _size)
         throw std::runtime_error("length + offset may not be greater than size()!");
     std::string error;
     if (!validateMapUsage(access, error))
         throw std::runtime_error("Invalid map usage:\n" + error);
     if ((access & MapUsage::Persistent) != MapUsage::None && (_flags & BufferFlag::MapPersistent) == BufferFlag::None)
         throw std::runtime_error("MapUsage::Persistent requires BufferFlag::MapPersistent to be set through setStorage!");
-    bind();
+    if (_immutable && (access & MapUsage::Read) != MapUsage::None && (_flags & BufferFlag::MapRead) == BufferFlag::None)
+        throw std::runtime_error("MapUsage::Read requires BufferFlag::MapRead to be set through setStorage!");
+    if (_immutable && (access & MapUsage::Write) != MapUsage::None && (_flags & BufferFlag::MapWrite) == BufferFlag::None)
+        throw std::runtime_error("MapUsage::Write requires BufferFlag::MapWrite to be set through setStorage!");
     void* ptr;
-    GL_CALL(ptr = glMapBufferRange(toGLenum(_type), offset, length, toGLenum(access)));
+    if (capabilities().directStateAccess) {
+        GL_CALL(ptr = glMapNamedBufferRange(_id, offset, length, toGLenum(access)));
+    } else {
+        bind();
+        GL_CALL(ptr = glMapBufferRange(toGLenum(_type), offset, length, toGLenum(access)));
+    }
     if (!ptr) throw std::runtime_error("glMapBufferRange returned nullptr");
     _mapped = true;
     _mapUsage = access;
+    _mapOffset = offset;
+    _mapLength = length;
+    _mapPointer = ptr;
+    VALIDATE_SHADOW();
     return ptr;
 }
 
-void Buffer::unmap() {
+void Buffer::flushMappedRange(int64_t offset, int64_t length) {
+    if (!_mapped || (_mapUsage & MapUsage::FlushExplicit) == MapUsage::None)
+        throw std::runtime_error("flushMappedRange requires the Buffer to be mapped with MapUsage::FlushExplicit!");
+    if (offset < 0)
+        throw std::runtime_error("offset may not be negative!");
+    if (length < 0)
+        throw std::runtime_error("length may not be negative!");
+    if (offset + length > _mapLength)
+        throw std::runtime_error("length + offset may not be greater than mapLength()!");
+    if (capabilities().directStateAccess) {
+        GL_CALL(glFlushMappedNamedBufferRange(_id, offset, length));
+        return;
+    }
     bind();
+    GL_CALL(glFlushMappedBufferRange(toGLenum(_type), offset, length));
+}
+
+void Buffer::unmap() {
+    if (!_mapped)
+        throw std::runtime_error("Buffer is not mapped!");
     bool ok;
-    GL_CALL(ok = glUnmapBuffer(toGLenum(_type)));
-    if (ok == GL_FALSE) {
-        _mapped = false;
-        _mapUsage = MapUsage::None;
-        throw std::runtime_error("glUnmapBuffer signalled data corruption");
+    if (capabilities().directStateAccess) {
+        GL_CALL(ok = glUnmapNamedBuffer(_id));
+    } else {
+        bind();
+        GL_CALL(ok = glUnmapBuffer(toGLenum(_type)));
     }
-    _mapped = false;
-    _mapUsage = MapUsage::None;
+    _resetMapping();
+    if (ok == GL_FALSE)
+        throw std::runtime_error("glUnmapBuffer signalled data corruption");
+    VALIDATE_SHADOW();
 }
 
 // --------------------------------------------------
@@ -259,11 +696,22 @@ Buffer& Buffer::operator=(Buffer&& other) {
         _delete();
         _id = other._id;
         _type = other._type;
-        _mapped = other._mapped;
+        _deletionQueue = other._deletionQueue;
+        _size = other._size;
+        _immutable = other._immutable;
+        _usage = other._usage;
         _flags = other._flags;
+        _mapped = other._mapped;
+        _mapUsage = other._mapUsage;
+        _mapOffset = other._mapOffset;
+        _mapLength = other._mapLength;
+        _mapPointer = other._mapPointer;
+        _updatePolicy = other._updatePolicy;
         other._id = 0;
-        other._mapped = false;
+        other._size = 0;
+        other._immutable = false;
         other._flags = BufferFlag::None;
+        other._resetMapping();
     }
     return *this;
 }
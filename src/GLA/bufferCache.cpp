@@ -0,0 +1,62 @@
+#include <GLA/bufferCache.h>
+
+namespace gla {
+
+// ----------------------------------------------------------------------------------------------------
+// class BufferCache
+// ----------------------------------------------------------------------------------------------------
+
+// --------------------------------------------------
+// protected methods
+// --------------------------------------------------
+
+std::shared_ptr<const Buffer> BufferCache::_get(const _Key& key, const void* data) {
+    auto it = _entries.find(key);
+    if (it != _entries.end()) {
+        if (std::shared_ptr<Buffer> buffer = it->second.lock()) {
+            _stats.hits++;
+            _stats.bytesSaved += key.size;
+            return buffer;
+        }
+    }
+
+    std::shared_ptr<Buffer> buffer = std::make_shared<Buffer>(key.type);
+    if (key.immutable)
+        buffer->setStorage(key.size, data, static_cast<BufferFlag>(key.mode));
+    else
+        buffer->setData(key.size, data, static_cast<BufferUsage>(key.mode));
+    _entries[key] = buffer;
+    _stats.misses++;
+    _stats.bytesUploaded += key.size;
+    return buffer;
+}
+
+// --------------------------------------------------
+// public methods
+// --------------------------------------------------
+
+std::shared_ptr<const Buffer> BufferCache::get(BufferType type, int64_t size, const void* data, BufferUsage usage) {
+    if (size < 0)
+        throw std::runtime_error("size may not be negative!");
+    return _get({ hash128(data, size), size, type, false, static_cast<uint32_t>(usage) }, data);
+}
+
+std::shared_ptr<const Buffer> BufferCache::get(BufferType type, int64_t size, const void* data, BufferFlag flags) {
+    if (size <= 0)
+        throw std::runtime_error("size must be greater than 0!");
+    std::string error;
+    if (!validateBufferFlag(flags, error))
+        throw std::runtime_error("Invalid Buffer Flags:\n" + error);
+    return _get({ hash128(data, size), size, type, true, static_cast<uint32_t>(flags) }, data);
+}
+
+void BufferCache::prune() {
+    for (auto it = _entries.begin(); it != _entries.end();) {
+        if (it->second.expired())
+            it = _entries.erase(it);
+        else
+            it++;
+    }
+}
+
+}
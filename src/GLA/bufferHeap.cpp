@@ -0,0 +1,106 @@
+#include <GLA/bufferHeap.h>
+
+#include <string>
+
+namespace gla {
+
+// ----------------------------------------------------------------------------------------------------
+// class BufferHeap
+// ----------------------------------------------------------------------------------------------------
+
+// --------------------------------------------------
+// protected methods
+// --------------------------------------------------
+
+uint32_t BufferHeap::_createBlock(int64_t size) {
+    std::unique_ptr<_Block> block(new _Block{ Buffer(_type), OffsetAllocator(size, _alignment) });
+    block->buffer.setStorage(size, nullptr, _flags);
+
+    for (size_t i = 0; i < _blocks.size(); i++) {
+        if (!_blocks[i]) {
+            _blocks[i] = std::move(block);
+            return static_cast<uint32_t>(i);
+        }
+    }
+    _blocks.push_back(std::move(block));
+    return static_cast<uint32_t>(_blocks.size() - 1);
+}
+
+// --------------------------------------------------
+// constructors / destructors
+// --------------------------------------------------
+
+BufferHeap::BufferHeap(BufferType type, int64_t blockSize, BufferFlag flags, int64_t alignment)
+    : _type(type), _flags(flags), _blockSize(blockSize), _alignment(alignment) {
+    if (alignment <= 0 || (alignment & (alignment - 1)) != 0)
+        throw std::invalid_argument("alignment must be a power of two!");
+    if (blockSize < alignment)
+        throw std::invalid_argument("blockSize may not be less than alignment!");
+    std::string error;
+    if (!validateBufferFlag(flags, error))
+        throw std::runtime_error("Invalid Buffer Flags:\n" + error);
+    _blockSize = (blockSize + alignment - 1) & ~(alignment - 1);
+}
+
+// --------------------------------------------------
+// public methods
+// --------------------------------------------------
+
+BufferSlice BufferHeap::allocate(int64_t size) {
+    if (size <= 0)
+        throw std::invalid_argument("size must be greater than 0!");
+
+    for (size_t i = 0; i < _blocks.size(); i++) {
+        if (!_blocks[i])
+            continue;
+        OffsetAllocation allocation = _blocks[i]->allocator.allocate(size);
+        if (allocation.valid())
+            return { &_blocks[i]->buffer, allocation.offset, allocation.size, (uint64_t(i) << 32) | allocation.node };
+    }
+
+    int64_t alignedSize = (size + _alignment - 1) & ~(_alignment - 1);
+    uint32_t index = _createBlock(alignedSize > _blockSize ? alignedSize : _blockSize);
+    OffsetAllocation allocation = _blocks[index]->allocator.allocate(size);
+    return { &_blocks[index]->buffer, allocation.offset, allocation.size, (uint64_t(index) << 32) | allocation.node };
+}
+
+void BufferHeap::free(BufferSlice& slice) {
+    uint64_t index = slice.handle >> 32;
+    if (index >= _blocks.size() || !_blocks[index] || &_blocks[index]->buffer != slice.buffer)
+        throw std::invalid_argument("BufferSlice was not allocated by this BufferHeap!");
+    OffsetAllocation allocation;
+    allocation.offset = slice.offset;
+    allocation.size = slice.size;
+    allocation.node = static_cast<uint32_t>(slice.handle & 0xFFFFFFFF);
+    _blocks[index]->allocator.free(allocation);
+    slice = {};
+}
+
+void BufferHeap::trim() {
+    for (std::unique_ptr<_Block>& block : _blocks)
+        if (block && block->allocator.allocations() == 0)
+            block.reset();
+    while (!_blocks.empty() && !_blocks.back())
+        _blocks.pop_back();
+}
+
+BufferHeapStats BufferHeap::stats() const {
+    BufferHeapStats stats;
+    for (const std::unique_ptr<_Block>& block : _blocks) {
+        if (!block)
+            continue;
+        const OffsetAllocator& allocator = block->allocator;
+        stats.blocks++;
+        stats.allocations += allocator.allocations();
+        stats.freeRegions += allocator.freeRegions();
+        stats.reservedBytes += allocator.size();
+        stats.usedBytes += allocator.usedBytes();
+        stats.freeBytes += allocator.freeBytes();
+        int64_t largest = allocator.largestFreeRegion();
+        if (largest > stats.largestFreeRegion)
+            stats.largestFreeRegion = largest;
+    }
+    return stats;
+}
+
+}
@@ -0,0 +1,138 @@
+#include <GLA/bufferPool.h>
+
+#include <bit>
+
+namespace gla {
+
+// ----------------------------------------------------------------------------------------------------
+// class BufferPool
+// ----------------------------------------------------------------------------------------------------
+
+// --------------------------------------------------
+// protected methods
+// --------------------------------------------------
+
+int64_t BufferPool::_sizeClass(int64_t size) {
+    if (size <= _MIN_SIZE)
+        return _MIN_SIZE;
+    return static_cast<int64_t>(std::bit_ceil(static_cast<uint64_t>(size)));
+}
+
+Buffer BufferPool::_acquire(const _Key& key) {
+    auto it = _idle.find(key);
+    if (it == _idle.end() || it->second.empty()) {
+        _stats.misses++;
+        Buffer buffer(key.type);
+        if (key.immutable)
+            buffer.setStorage(key.size, nullptr, static_cast<BufferFlag>(key.mode));
+        else
+            buffer.setData(key.size, nullptr, static_cast<BufferUsage>(key.mode));
+        return buffer;
+    }
+    _stats.hits++;
+    Buffer buffer = std::move(it->second.back().buffer);
+    it->second.pop_back();
+    if (it->second.empty())
+        _idle.erase(it);
+    _stats.idleBuffers--;
+    _stats.idleBytes -= key.size;
+    return buffer;
+}
+
+void BufferPool::_evict(std::map<_Key, std::deque<_Idle>>::iterator it) {
+    it->second.pop_front(); // the Buffer is destroyed through the DeletionQueue
+    _stats.evictions++;
+    _stats.idleBuffers--;
+    _stats.idleBytes -= it->first.size;
+    if (it->second.empty())
+        _idle.erase(it);
+}
+
+// --------------------------------------------------
+// constructors / destructors
+// --------------------------------------------------
+
+BufferPool::BufferPool(BufferPoolLimits limits) : _limits(limits) {}
+
+// --------------------------------------------------
+// public methods
+// --------------------------------------------------
+
+Buffer BufferPool::acquire(BufferType type, int64_t size, BufferUsage usage) {
+    if (size <= 0)
+        throw std::invalid_argument("size must be greater than 0!");
+    return _acquire({ type, false, static_cast<uint32_t>(usage), _sizeClass(size) });
+}
+
+Buffer BufferPool::acquire(BufferType type, int64_t size, BufferFlag flags) {
+    if (size <= 0)
+        throw std::invalid_argument("size must be greater than 0!");
+    std::string error;
+    if (!validateBufferFlag(flags, error))
+        throw std::runtime_error("Invalid Buffer Flags:\n" + error);
+    return _acquire({ type, true, static_cast<uint32_t>(flags), _sizeClass(size) });
+}
+
+void BufferPool::release(Buffer&& buffer) {
+    Buffer released = std::move(buffer);
+    if (released.size() <= 0 || _sizeClass(released.size()) != released.size())
+        return;
+    if (released.mapped() && (released.getMapUsage() & MapUsage::Persistent) == MapUsage::None)
+        released.unmap();
+    released.setUpdatePolicy(UpdatePolicy::SubData);
+    uint32_t mode = released.immutable() ? static_cast<uint32_t>(released.getFlags()) : static_cast<uint32_t>(released.getUsage());
+    _Key key = { released.getType(), released.immutable(), mode, released.size() };
+    _released.emplace_back(key, std::move(released));
+    _stats.releases++;
+    _stats.inFlight++;
+}
+
+void BufferPool::endFrame() {
+    _frame++;
+    if (!_released.empty()) {
+        _Batch batch;
+        batch.buffers.swap(_released);
+        batch.fence.insert();
+        _inFlight.push_back(std::move(batch));
+    }
+
+    while (!_inFlight.empty() && _inFlight.front().fence.signaled()) {
+        for (auto& [key, buffer] : _inFlight.front().buffers) {
+            _idle[key].push_back({ std::move(buffer), _frame });
+            _stats.inFlight--;
+            _stats.idleBuffers++;
+            _stats.idleBytes += key.size;
+        }
+        _inFlight.pop_front();
+    }
+
+    // per class limits, the least recently used Buffers are at the front
+    for (auto it = _idle.begin(); it != _idle.end();) {
+        auto next = std::next(it);
+        while (it->second.size() > _limits.maxBuffersPerClass || _frame - it->second.front().lastUsedFrame > _limits.maxIdleFrames) {
+            bool last = it->second.size() == 1;
+            _evict(it);
+            if (last)
+                break;
+        }
+        it = next;
+    }
+
+    // global byte limit, evict the least recently used Buffer over all classes
+    while (_stats.idleBytes > _limits.maxBytes && !_idle.empty()) {
+        auto oldest = _idle.begin();
+        for (auto it = _idle.begin(); it != _idle.end(); it++)
+            if (it->second.front().lastUsedFrame < oldest->second.front().lastUsedFrame)
+                oldest = it;
+        _evict(oldest);
+    }
+}
+
+void BufferPool::clear() {
+    _stats.evictions += _stats.idleBuffers;
+    _idle.clear();
+    _stats.idleBuffers = 0;
+    _stats.idleBytes = 0;
+}
+
+}
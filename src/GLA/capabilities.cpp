@@ -0,0 +1,54 @@
+#include <GLA/capabilities.h>
+
+#include <GL/glew.h>
+
+namespace gla {
+
+namespace {
+    Capabilities currentCapabilities = {};
+}
+
+void queryCapabilities() {
+    Capabilities caps;
+    caps.directStateAccess = GLEW_VERSION_4_5 || GLEW_ARB_direct_state_access;
+    caps.invalidateSubdata = GLEW_VERSION_4_3 || GLEW_ARB_invalidate_subdata;
+    caps.multiBind = GLEW_VERSION_4_4 || GLEW_ARB_multi_bind;
+    caps.sparseBuffer = GLEW_ARB_sparse_buffer;
+    caps.gpuMemoryInfo = GLEW_NVX_gpu_memory_info;
+    caps.memInfo = GLEW_ATI_meminfo;
+    caps.vertexAttribBinding = GLEW_VERSION_4_3 || GLEW_ARB_vertex_attrib_binding;
+    caps.primitiveRestartFixedIndex = GLEW_VERSION_4_3 || GLEW_ARB_ES3_compatibility;
+
+    GLint alignment = 0;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    if (alignment > 0)
+        caps.uniformBufferOffsetAlignment = alignment;
+    alignment = 0;
+    if (GLEW_VERSION_4_3 || GLEW_ARB_shader_storage_buffer_object)
+        glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    if (alignment > 0)
+        caps.shaderStorageBufferOffsetAlignment = alignment;
+    if (caps.sparseBuffer) {
+        GLint pageSize = 0;
+        glGetIntegerv(GL_SPARSE_BUFFER_PAGE_SIZE_ARB, &pageSize);
+        if (pageSize > 0)
+            caps.sparseBufferPageSize = pageSize;
+    }
+    GLint maxVertexAttribs = 0;
+    glGetIntegerv(GL_MAX_VERTEX_ATTRIBS, &maxVertexAttribs);
+    if (maxVertexAttribs > 0)
+        caps.maxVertexAttribs = maxVertexAttribs;
+    if (caps.vertexAttribBinding) {
+        GLint maxBindings = 0;
+        glGetIntegerv(GL_MAX_VERTEX_ATTRIB_BINDINGS, &maxBindings);
+        if (maxBindings > 0)
+            caps.maxVertexAttribBindings = maxBindings;
+    }
+    currentCapabilities = caps;
+}
+
+const Capabilities& capabilities() {
+    return currentCapabilities;
+}
+
+}
@@ -0,0 +1,155 @@
+#include <GLA/deletionQueue.h>
+
+#include <GLA/debug.h>
+#include <GLA/stateCache.h>
+
+#include <GL/glew.h>
+
+namespace gla {
+
+namespace {
+    thread_local DeletionQueue* currentQueue = nullptr;
+    DeletionQueue fallbackQueue; // never enabled, so it never holds names of any context
+}
+
+DeletionQueue& deletionQueue() {
+    return DeletionQueue::current();
+}
+
+// ----------------------------------------------------------------------------------------------------
+// class DeletionQueue
+// ----------------------------------------------------------------------------------------------------
+
+// --------------------------------------------------
+// protected methods
+// --------------------------------------------------
+
+void DeletionQueue::_destroy(const _Entry& entry) {
+    switch (entry.type)
+    {
+    case DeletionType::Buffer:
+        GL_CALL(glDeleteBuffers(1, &entry.id));
+        StateCache::current().forgetBuffer(entry.id);
+        break;
+    case DeletionType::Shader:
+        GL_CALL(glDeleteShader(entry.id));
+        break;
+    case DeletionType::Program:
+        GL_CALL(glDeleteProgram(entry.id));
+        StateCache::current().forgetProgram(entry.id);
+        break;
+    case DeletionType::VertexArray:
+        GL_CALL(glDeleteVertexArrays(1, &entry.id));
+        StateCache::current().forgetVertexArray(entry.id);
+        break;
+    }
+}
+
+void DeletionQueue::_retire(_Frame& frame) {
+    for (const _Entry& entry : frame.entries)
+        _destroy(entry);
+}
+
+// --------------------------------------------------
+// public methods
+// --------------------------------------------------
+
+DeletionQueue& DeletionQueue::current() {
+    return currentQueue ? *currentQueue : fallbackQueue;
+}
+
+void DeletionQueue::makeCurrent(DeletionQueue* queue) {
+    currentQueue = queue;
+}
+
+bool DeletionQueue::isCurrent(const DeletionQueue* queue) {
+    return currentQueue == queue;
+}
+
+void DeletionQueue::push(DeletionType type, unsigned int id) {
+    if (id == 0)
+        return;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_enabled) {
+            _pending.push_back({ type, id });
+            _stats.deferred++;
+            _stats.queueDepth++;
+            return;
+        }
+    }
+    _destroy({ type, id });
+}
+
+void DeletionQueue::endFrame() {
+    _Frame frame;
+    std::deque<_Frame> finished;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        frame.entries.swap(_pending);
+        while (!_frames.empty() && _frames.front().fence.signaled()) {
+            finished.push_back(std::move(_frames.front()));
+            _frames.pop_front();
+        }
+        if (!frame.entries.empty()) {
+            frame.fence.insert();
+            _frames.push_back(std::move(frame));
+        }
+    }
+
+    uint64_t retired = 0;
+    for (_Frame& done : finished) {
+        _retire(done);
+        retired += done.entries.size();
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stats.retired += retired;
+    _stats.retiredLastFrame = retired;
+    _stats.queueDepth -= retired;
+    _stats.framesInFlight = static_cast<uint32_t>(_frames.size());
+}
+
+void DeletionQueue::drain() {
+    std::vector<_Entry> pending;
+    std::deque<_Frame> frames;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        pending.swap(_pending);
+        frames.swap(_frames);
+    }
+
+    uint64_t retired = pending.size();
+    for (_Frame& frame : frames) {
+        _retire(frame);
+        retired += frame.entries.size();
+    }
+    for (const _Entry& entry : pending)
+        _destroy(entry);
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stats.retired += retired;
+    _stats.queueDepth -= retired;
+    _stats.framesInFlight = static_cast<uint32_t>(_frames.size());
+}
+
+void DeletionQueue::setEnabled(bool enabled) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _enabled = enabled;
+    }
+    if (!enabled)
+        drain();
+}
+
+bool DeletionQueue::enabled() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _enabled;
+}
+
+DeletionQueueStats DeletionQueue::stats() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _stats;
+}
+
+}
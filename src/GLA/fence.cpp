@@ -0,0 +1,90 @@
+#include <GLA/fence.h>
+
+#include <GLA/debug.h>
+
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+
+namespace gla {
+
+// ----------------------------------------------------------------------------------------------------
+// class Fence
+// ----------------------------------------------------------------------------------------------------
+
+// --------------------------------------------------
+// protected methods
+// --------------------------------------------------
+
+void Fence::_delete() {
+    if (_sync != nullptr)
+        GL_CALL(glDeleteSync(static_cast<GLsync>(_sync)));
+    _sync = nullptr;
+}
+
+// --------------------------------------------------
+// constructors / destructors
+// --------------------------------------------------
+
+Fence::Fence(Fence&& other) : _sync(other._sync) {
+    other._sync = nullptr;
+}
+
+Fence::~Fence() noexcept {
+    _delete();
+}
+
+// --------------------------------------------------
+// public methods
+// --------------------------------------------------
+
+void Fence::insert() {
+    _delete();
+    GLsync sync;
+    GL_CALL(sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+    if (sync == nullptr)
+        throw std::runtime_error("Failed to create sync object!");
+    _sync = sync;
+}
+
+void Fence::reset() {
+    _delete();
+}
+
+bool Fence::signaled() const {
+    if (_sync == nullptr)
+        return true;
+    GLenum result;
+    GL_CALL(result = glClientWaitSync(static_cast<GLsync>(_sync), 0, 0));
+    if (result == GL_WAIT_FAILED)
+        throw std::runtime_error("glClientWaitSync failed!");
+    return result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED;
+}
+
+bool Fence::wait(uint64_t timeout) {
+    if (_sync == nullptr)
+        return true;
+    GLenum result;
+    GL_CALL(result = glClientWaitSync(static_cast<GLsync>(_sync), GL_SYNC_FLUSH_COMMANDS_BIT, timeout));
+    if (result == GL_WAIT_FAILED)
+        throw std::runtime_error("glClientWaitSync failed!");
+    return result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED;
+}
+
+void Fence::wait() {
+    while (!wait(1000000)) {}
+}
+
+// --------------------------------------------------
+// operator overloads
+// --------------------------------------------------
+
+Fence& Fence::operator=(Fence&& other) {
+    if (this != &other) {
+        _delete();
+        _sync = other._sync;
+        other._sync = nullptr;
+    }
+    return *this;
+}
+
+}
@@ -0,0 +1,179 @@
+#include <GLA/fileMapping.h>
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #define NOMINMAX
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace gla {
+
+// ----------------------------------------------------------------------------------------------------
+// class FileMapping
+// ----------------------------------------------------------------------------------------------------
+
+// --------------------------------------------------
+// protected methods
+// --------------------------------------------------
+
+void FileMapping::_close() {
+    unmap();
+#ifdef _WIN32
+    if (_mapping != 0)
+        CloseHandle(reinterpret_cast<HANDLE>(_mapping));
+    if (_file != -1)
+        CloseHandle(reinterpret_cast<HANDLE>(_file));
+#else
+    if (_file != -1)
+        close(static_cast<int>(_file));
+#endif
+    _file = -1;
+    _mapping = 0;
+    _size = 0;
+}
+
+// --------------------------------------------------
+// constructors / destructors
+// --------------------------------------------------
+
+FileMapping::FileMapping(const std::string& path) {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        throw std::runtime_error("Could not open file \"" + path + "\"!");
+    _file = reinterpret_cast<intptr_t>(file);
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) {
+        _close();
+        throw std::runtime_error("Could not query the size of file \"" + path + "\"!");
+    }
+    _size = size.QuadPart;
+    if (_size > 0) {
+        HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (mapping == NULL) {
+            _close();
+            throw std::runtime_error("Could not create a mapping of file \"" + path + "\"!");
+        }
+        _mapping = reinterpret_cast<intptr_t>(mapping);
+    }
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1)
+        throw std::runtime_error("Could not open file \"" + path + "\"!");
+    _file = fd;
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        _close();
+        throw std::runtime_error("Could not query the size of file \"" + path + "\"!");
+    }
+    _size = info.st_size;
+#endif
+}
+
+FileMapping::FileMapping(FileMapping&& other)
+    : _file(other._file), _mapping(other._mapping), _size(other._size), _view(other._view), _viewSize(other._viewSize),
+      _offset(other._offset), _length(other._length) {
+    other._file = -1;
+    other._mapping = 0;
+    other._size = 0;
+    other._view = nullptr;
+    other._viewSize = 0;
+    other._offset = 0;
+    other._length = 0;
+}
+
+FileMapping::~FileMapping() noexcept {
+    _close();
+}
+
+// --------------------------------------------------
+// public methods
+// --------------------------------------------------
+
+int64_t FileMapping::granularity() {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwAllocationGranularity;
+#else
+    return sysconf(_SC_PAGESIZE);
+#endif
+}
+
+const char* FileMapping::map(int64_t offset, int64_t length) {
+    if (!valid())
+        throw std::logic_error("FileMapping has no open file!");
+    if (offset < 0)
+        throw std::runtime_error("offset may not be negative!");
+    if (length <= 0)
+        throw std::runtime_error("length must be greater than 0!");
+    if (offset + length > _size)
+        throw std::runtime_error("length + offset may not be greater than size()!");
+    unmap();
+
+    int64_t viewOffset = offset - offset % granularity();
+    int64_t viewSize = offset + length - viewOffset;
+#ifdef _WIN32
+    void* view = MapViewOfFile(reinterpret_cast<HANDLE>(_mapping), FILE_MAP_READ,
+        static_cast<DWORD>(viewOffset >> 32), static_cast<DWORD>(viewOffset & 0xFFFFFFFF), static_cast<SIZE_T>(viewSize));
+    if (view == NULL)
+        throw std::runtime_error("Could not map a view of the file!");
+#else
+    void* view = mmap(nullptr, viewSize, PROT_READ, MAP_PRIVATE, static_cast<int>(_file), viewOffset);
+    if (view == MAP_FAILED)
+        throw std::runtime_error("Could not map a view of the file!");
+    madvise(view, viewSize, MADV_SEQUENTIAL);
+    madvise(view, viewSize, MADV_WILLNEED);
+#endif
+    _view = view;
+    _viewSize = viewSize;
+    _offset = offset;
+    _length = length;
+    return static_cast<const char*>(view) + (offset - viewOffset);
+}
+
+void FileMapping::unmap() {
+    if (_view == nullptr)
+        return;
+#ifdef _WIN32
+    UnmapViewOfFile(_view);
+#else
+    munmap(_view, _viewSize);
+#endif
+    _view = nullptr;
+    _viewSize = 0;
+    _offset = 0;
+    _length = 0;
+}
+
+// --------------------------------------------------
+// operator overloads
+// --------------------------------------------------
+
+FileMapping& FileMapping::operator=(FileMapping&& other) {
+    if (this != &other) {
+        _close();
+        _file = other._file;
+        _mapping = other._mapping;
+        _size = other._size;
+        _view = other._view;
+        _viewSize = other._viewSize;
+        _offset = other._offset;
+        _length = other._length;
+        other._file = -1;
+        other._mapping = 0;
+        other._size = 0;
+        other._view = nullptr;
+        other._viewSize = 0;
+        other._offset = 0;
+        other._length = 0;
+    }
+    return *this;
+}
+
+}
@@ -0,0 +1,105 @@
+#include <GLA/hash.h>
+
+#include <bit>
+#include <cstring>
+
+namespace gla {
+
+namespace {
+    constexpr uint64_t PRIME1 = 0x9E3779B185EBCA87ull;
+    constexpr uint64_t PRIME2 = 0xC2B2AE3D27D4EB4Full;
+    constexpr uint64_t PRIME3 = 0x165667B19E3779F9ull;
+    constexpr uint64_t PRIME4 = 0x85EBCA77C2B2AE63ull;
+    constexpr uint64_t PRIME5 = 0x27D4EB2F165667C5ull;
+
+    inline uint64_t read64(const unsigned char* p) {
+        uint64_t value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    inline uint32_t read32(const unsigned char* p) {
+        uint32_t value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    inline uint64_t round(uint64_t acc, uint64_t input) {
+        acc += input * PRIME2;
+        acc = std::rotl(acc, 31);
+        return acc * PRIME1;
+    }
+
+    inline uint64_t mergeRound(uint64_t acc, uint64_t value) {
+        acc ^= round(0, value);
+        return acc * PRIME1 + PRIME4;
+    }
+
+    inline uint64_t avalanche(uint64_t h) {
+        h ^= h >> 33;
+        h *= PRIME2;
+        h ^= h >> 29;
+        h *= PRIME3;
+        h ^= h >> 32;
+        return h;
+    }
+}
+
+Hash128 hash128(const void* data, size_t size, uint64_t seed) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    const unsigned char* end = p + size;
+
+    uint64_t v1 = seed + PRIME1 + PRIME2;
+    uint64_t v2 = seed + PRIME2;
+    uint64_t v3 = seed;
+    uint64_t v4 = seed - PRIME1;
+
+    uint64_t h;
+    if (size >= 32) {
+        const unsigned char* limit = end - 32;
+        do {
+            v1 = round(v1, read64(p));
+            v2 = round(v2, read64(p + 8));
+            v3 = round(v3, read64(p + 16));
+            v4 = round(v4, read64(p + 24));
+            p += 32;
+        } while (p <= limit);
+
+        h = std::rotl(v1, 1) + std::rotl(v2, 7) + std::rotl(v3, 12) + std::rotl(v4, 18);
+        h = mergeRound(h, v1);
+        h = mergeRound(h, v2);
+        h = mergeRound(h, v3);
+        h = mergeRound(h, v4);
+    } else {
+        h = seed + PRIME5;
+    }
+    h += static_cast<uint64_t>(size);
+    // second accumulator over the tail with other constants, so the halves are independent for short inputs too
+    uint64_t t = (seed ^ PRIME3) + static_cast<uint64_t>(size) * PRIME2;
+
+    // tail of less than 32 bytes
+    for (; p + 8 <= end; p += 8) {
+        uint64_t k = read64(p);
+        h = std::rotl(h ^ round(0, k), 27) * PRIME1 + PRIME4;
+        t = std::rotl(t ^ (k * PRIME3), 29) * PRIME4 + PRIME5;
+    }
+    if (p + 4 <= end) {
+        uint64_t k = read32(p);
+        h = std::rotl(h ^ (k * PRIME1), 23) * PRIME2 + PRIME3;
+        t = std::rotl(t ^ (k * PRIME4), 19) * PRIME5 + PRIME1;
+        p += 4;
+    }
+    for (; p < end; p++) {
+        h = std::rotl(h ^ (*p * PRIME5), 11) * PRIME1;
+        t = std::rotl(t ^ (*p * PRIME2), 13) * PRIME3;
+    }
+
+    Hash128 result;
+    result.low = avalanche(h);
+    // second half from the lane states in a different order and the second tail accumulator, never from h alone
+    uint64_t g = (std::rotl(v1, 7) * PRIME3) ^ (std::rotl(v2, 13) * PRIME4) ^ (std::rotl(v3, 19) * PRIME5) ^ (std::rotl(v4, 29) * PRIME2);
+    result.high = avalanche(g ^ t);
+    return result;
+}
+
+}
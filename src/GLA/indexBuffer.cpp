@@ -0,0 +1,180 @@
+#include <GLA/indexBuffer.h>
+
+#include <GLA/capabilities.h>
+#include <GLA/debug.h>
+#include <GLA/hash.h>
+#include <GLA/stateCache.h>
+
+#include <GL/glew.h>
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <limits>
+
+namespace gla {
+
+unsigned int toGLenum(IndexType type) {
+    switch (type)
+    {
+    case IndexType::UnsignedShort:  return GL_UNSIGNED_SHORT;
+    case IndexType::UnsignedInt:    return GL_UNSIGNED_INT;
+    }
+    throw std::invalid_argument("IndexType is invalid!");
+}
+
+unsigned int toGLenum(PrimitiveMode mode) {
+    switch (mode)
+    {
+    case PrimitiveMode::Points:         return GL_POINTS;
+    case PrimitiveMode::Lines:          return GL_LINES;
+    case PrimitiveMode::LineStrip:      return GL_LINE_STRIP;
+    case PrimitiveMode::LineLoop:       return GL_LINE_LOOP;
+    case PrimitiveMode::Triangles:      return GL_TRIANGLES;
+    case PrimitiveMode::TriangleStrip:  return GL_TRIANGLE_STRIP;
+    case PrimitiveMode::TriangleFan:    return GL_TRIANGLE_FAN;
+    }
+    throw std::invalid_argument("PrimitiveMode is invalid!");
+}
+
+// ----------------------------------------------------------------------------------------------------
+// class IndexBuffer
+// ----------------------------------------------------------------------------------------------------
+
+// --------------------------------------------------
+// protected methods
+// --------------------------------------------------
+
+void IndexBuffer::_draw(PrimitiveMode mode, int64_t first, int64_t count, int instances) const {
+    if (instances <= 0)
+        throw std::invalid_argument("instances must be greater than 0!");
+    if (count == 0)
+        return;
+
+    if (_restart) {
+        if (capabilities().primitiveRestartFixedIndex) {
+            GL_CALL(glEnable(GL_PRIMITIVE_RESTART_FIXED_INDEX));
+        } else {
+            GL_CALL(glEnable(GL_PRIMITIVE_RESTART));
+            GL_CALL(glPrimitiveRestartIndex(_type == IndexType::UnsignedShort ? 0xFFFF : RESTART));
+        }
+    }
+
+    const void* offset = reinterpret_cast<const void*>(static_cast<intptr_t>(first * indexBytes(_type)));
+    if (instances == 1)
+        GL_CALL(glDrawElements(toGLenum(mode), static_cast<GLsizei>(count), toGLenum(_type), offset));
+    else
+        GL_CALL(glDrawElementsInstanced(toGLenum(mode), static_cast<GLsizei>(count), toGLenum(_type), offset, instances));
+
+    if (_restart)
+        GL_CALL(glDisable(capabilities().primitiveRestartFixedIndex ? GL_PRIMITIVE_RESTART_FIXED_INDEX : GL_PRIMITIVE_RESTART));
+}
+
+// --------------------------------------------------
+// constructors / destructors
+// --------------------------------------------------
+
+IndexBuffer::IndexBuffer() : _buffer(BufferType::ElementArray) {}
+
+// --------------------------------------------------
+// public methods
+// --------------------------------------------------
+
+void IndexBuffer::setIndices(std::span<const uint32_t> indices, BufferUsage usage) {
+    uint32_t maxIndex = 0;
+    bool restart = false;
+    for (uint32_t index : indices) {
+        if (index == RESTART)
+            restart = true;
+        else
+            maxIndex = std::max(maxIndex, index);
+    }
+
+    // 0xFFFF is the restart index of 16 bit indices, so it can't be used as a vertex index
+    IndexType type = maxIndex < 0xFFFF ? IndexType::UnsignedShort : IndexType::UnsignedInt;
+    int64_t count = static_cast<int64_t>(indices.size());
+
+    // without DSA the upload binds GL_ELEMENT_ARRAY_BUFFER, which would replace the element Buffer of the bound VAO
+    StateCache& cache = StateCache::current();
+    unsigned int vertexArray = 0;
+    if (!capabilities().directStateAccess) {
+        vertexArray = cache.vertexArray();
+        cache.bindVertexArray(0);
+    }
+    try {
+        if (type == IndexType::UnsignedShort) {
+            _buffer.setData<uint16_t>(count, [&](std::span<uint16_t> dst) {
+                for (size_t i = 0; i < indices.size(); i++)
+                    dst[i] = static_cast<uint16_t>(indices[i]); // RESTART narrows to 0xFFFF
+            }, usage);
+        } else {
+            _buffer.setData(indices, usage);
+        }
+    } catch (...) {
+        if (!capabilities().directStateAccess)
+            cache.bindVertexArray(vertexArray);
+        throw;
+    }
+    if (!capabilities().directStateAccess)
+        cache.bindVertexArray(vertexArray);
+
+    _type = type;
+    _count = count;
+    _maxIndex = maxIndex;
+    _restart = restart;
+}
+
+void IndexBuffer::draw(PrimitiveMode mode, int64_t first, int64_t count, int instances) const {
+    if (first < 0 || count < 0 || first + count > _count)
+        throw std::out_of_range("Range is not within the indices!");
+    _draw(mode, first, count, instances);
+}
+
+// ----------------------------------------------------------------------------------------------------
+// vertex welding
+// ----------------------------------------------------------------------------------------------------
+
+size_t weldVertices(void* vertices, size_t count, int stride, std::vector<uint32_t>& indices) {
+    if (stride <= 0)
+        throw std::invalid_argument("stride must be greater than 0!");
+    if (count >= IndexBuffer::RESTART)
+        throw std::length_error("Too many vertices for 32 bit indices!");
+
+    unsigned char* data = static_cast<unsigned char*>(vertices);
+    size_t size = static_cast<size_t>(stride);
+    indices.resize(count);
+
+    // open addressing with linear probing, at most half full so probe sequences stay short
+    size_t capacity = std::bit_ceil(std::max<size_t>(16, count * 2));
+    size_t mask = capacity - 1;
+    std::vector<uint32_t> table(capacity, IndexBuffer::RESTART);
+    std::vector<Hash128> hashes;
+    hashes.reserve(count);
+
+    size_t unique = 0;
+    for (size_t i = 0; i < count; i++) {
+        const unsigned char* vertex = data + i * size;
+        Hash128 hash = hash128(vertex, size);
+        size_t slot = static_cast<size_t>(hash.low) & mask;
+        while (true) {
+            uint32_t entry = table[slot];
+            if (entry == IndexBuffer::RESTART) {
+                // unique vertices only move towards the front, so entries always refer to compacted vertices
+                if (unique != i)
+                    std::memcpy(data + unique * size, vertex, size);
+                table[slot] = static_cast<uint32_t>(unique);
+                hashes.push_back(hash);
+                indices[i] = static_cast<uint32_t>(unique++);
+                break;
+            }
+            if (hashes[entry] == hash && std::memcmp(data + entry * size, vertex, size) == 0) {
+                indices[i] = entry;
+                break;
+            }
+            slot = (slot + 1) & mask;
+        }
+    }
+    return unique;
+}
+
+}
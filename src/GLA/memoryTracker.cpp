@@ -0,0 +1,145 @@
+#include <GLA/memoryTracker.h>
+
+#include <GLA/capabilities.h>
+#include <GLA/debug.h>
+
+#include <GL/glew.h>
+
+#include <sstream>
+
+namespace gla {
+
+namespace {
+    MemoryTracker globalMemoryTracker;
+
+    constexpr const char* OBJECT_NAMES[TRACKED_OBJECT_COUNT] = { "Buffer", "Shader", "Program", "VertexArrayObject" };
+    constexpr const char* TYPE_NAMES[BUFFER_TYPE_COUNT] = {
+        "Array", "AtomicCounter", "CopyRead", "CopyWrite", "DispatchIndirect", "DrawIndirect", "ElementArray",
+        "PixelPack", "PixelUnpack", "Query", "ShaderStorage", "Texture", "TransformFeedback", "Uniform"
+    };
+
+    void raise(std::atomic<int64_t>& mark, int64_t value) {
+        int64_t current = mark.load(std::memory_order_relaxed);
+        while (value > current && !mark.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+    }
+}
+
+MemoryTracker& memoryTracker() {
+    return globalMemoryTracker;
+}
+
+BufferStorageClass storageClass(bool immutable, BufferFlag flags) {
+    if (!immutable)
+        return BufferStorageClass::Mutable;
+    if ((flags & BufferFlag::Sparse) != BufferFlag::None)
+        return BufferStorageClass::Sparse;
+    if ((flags & BufferFlag::MapPersistent) != BufferFlag::None)
+        return BufferStorageClass::Persistent;
+    if ((flags & (BufferFlag::MapRead | BufferFlag::MapWrite)) != BufferFlag::None)
+        return BufferStorageClass::Mapped;
+    if ((flags & BufferFlag::DynamicStorage) != BufferFlag::None)
+        return BufferStorageClass::Dynamic;
+    return BufferStorageClass::Static;
+}
+
+// ----------------------------------------------------------------------------------------------------
+// class MemoryTracker
+// ----------------------------------------------------------------------------------------------------
+
+// --------------------------------------------------
+// protected methods
+// --------------------------------------------------
+
+void MemoryTracker::_account(BufferType type, bool immutable, BufferUsage usage, BufferFlag flags, int64_t bytes) {
+    _byType[static_cast<size_t>(type)].fetch_add(bytes, std::memory_order_relaxed);
+    if (!immutable)
+        _byUsage[static_cast<size_t>(usage)].fetch_add(bytes, std::memory_order_relaxed);
+    _byStorageClass[static_cast<size_t>(storageClass(immutable, flags))].fetch_add(bytes, std::memory_order_relaxed);
+    int64_t total = _bufferBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    if (bytes > 0) {
+        raise(_highWater, total);
+        raise(_frameHighWater, total);
+    }
+}
+
+// --------------------------------------------------
+// public methods
+// --------------------------------------------------
+
+void MemoryTracker::objectCreated(TrackedObject object) {
+    _live[static_cast<size_t>(object)].fetch_add(1, std::memory_order_relaxed);
+}
+
+void MemoryTracker::objectDestroyed(TrackedObject object) {
+    _live[static_cast<size_t>(object)].fetch_sub(1, std::memory_order_relaxed);
+}
+
+void MemoryTracker::bufferAllocated(BufferType type, bool immutable, BufferUsage usage, BufferFlag flags, int64_t size) {
+    if (size > 0)
+        _account(type, immutable, usage, flags, size);
+}
+
+void MemoryTracker::bufferReleased(BufferType type, bool immutable, BufferUsage usage, BufferFlag flags, int64_t size) {
+    if (size > 0)
+        _account(type, immutable, usage, flags, -size);
+}
+
+void MemoryTracker::endFrame() {
+    int64_t current = _bufferBytes.load(std::memory_order_relaxed);
+    _lastFrameHighWater.store(_frameHighWater.exchange(current, std::memory_order_relaxed), std::memory_order_relaxed);
+    _frames.fetch_add(1, std::memory_order_relaxed);
+}
+
+MemorySnapshot MemoryTracker::snapshot(bool queryDriver) const {
+    MemorySnapshot snapshot;
+    snapshot.bufferBytes = _bufferBytes.load(std::memory_order_relaxed);
+    snapshot.highWaterBytes = _highWater.load(std::memory_order_relaxed);
+    snapshot.frameHighWaterBytes = _lastFrameHighWater.load(std::memory_order_relaxed);
+    snapshot.frames = _frames.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < BUFFER_TYPE_COUNT; i++)
+        snapshot.bytesByType[i] = _byType[i].load(std::memory_order_relaxed);
+    for (size_t i = 0; i < BUFFER_USAGE_COUNT; i++)
+        snapshot.bytesByUsage[i] = _byUsage[i].load(std::memory_order_relaxed);
+    for (size_t i = 0; i < BUFFER_STORAGE_CLASS_COUNT; i++)
+        snapshot.bytesByStorageClass[i] = _byStorageClass[i].load(std::memory_order_relaxed);
+    for (size_t i = 0; i < TRACKED_OBJECT_COUNT; i++)
+        snapshot.liveObjects[i] = _live[i].load(std::memory_order_relaxed);
+
+    if (queryDriver) {
+        if (capabilities().gpuMemoryInfo) {
+            GLint total = 0, available = 0;
+            GL_CALL(glGetIntegerv(GL_GPU_MEMORY_INFO_DEDICATED_VIDMEM_NVX, &total));
+            GL_CALL(glGetIntegerv(GL_GPU_MEMORY_INFO_CURRENT_AVAILABLE_VIDMEM_NVX, &available));
+            snapshot.driverTotalKB = total;
+            snapshot.driverAvailableKB = available;
+        } else if (capabilities().memInfo) {
+            // total free, largest free block, total auxiliary free, largest auxiliary free block
+            GLint info[4] = {};
+            GL_CALL(glGetIntegerv(GL_VBO_FREE_MEMORY_ATI, info));
+            snapshot.driverAvailableKB = info[0];
+        }
+    }
+    return snapshot;
+}
+
+std::string MemoryTracker::leakReport() const {
+    MemorySnapshot snapshot = this->snapshot();
+    bool leaked = snapshot.bufferBytes != 0;
+    for (int64_t live : snapshot.liveObjects)
+        leaked |= live != 0;
+    if (!leaked)
+        return "";
+
+    std::ostringstream report;
+    report << "GLA objects alive at context teardown:\n";
+    for (size_t i = 0; i < TRACKED_OBJECT_COUNT; i++)
+        if (snapshot.liveObjects[i] != 0)
+            report << "  " << OBJECT_NAMES[i] << ": " << snapshot.liveObjects[i] << "\n";
+    for (size_t i = 0; i < BUFFER_TYPE_COUNT; i++)
+        if (snapshot.bytesByType[i] != 0)
+            report << "  " << TYPE_NAMES[i] << " Buffer bytes: " << snapshot.bytesByType[i] << "\n";
+    report << "  total Buffer bytes: " << snapshot.bufferBytes << " (high-water " << snapshot.highWaterBytes << ")\n";
+    return report.str();
+}
+
+}
@@ -0,0 +1,298 @@
+#include <GLA/meshOptimizer.h>
+
+#include <glm/vec3.hpp>
+#include <glm/geometric.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+
+namespace gla {
+
+namespace {
+    constexpr uint32_t UNUSED = 0xFFFFFFFF;
+
+    // Forsyth's scoring constants, tuned for caches of 16 to 32 entries
+    constexpr int SCORE_CACHE_SIZE = 32;
+    constexpr float LAST_TRIANGLE_SCORE = 0.75f;
+    constexpr float CACHE_DECAY_POWER = 1.5f;
+    constexpr float VALENCE_BOOST_SCALE = 2.0f;
+    constexpr float VALENCE_BOOST_POWER = 0.5f;
+
+    void checkTriangles(std::span<const uint32_t> indices, size_t vertexCount) {
+        if (indices.size() % 3 != 0)
+            throw std::invalid_argument("The number of indices must be a multiple of 3!");
+        for (uint32_t index : indices)
+            if (index >= vertexCount)
+                throw std::out_of_range("Index is not below the vertex count!");
+    }
+
+    float vertexScore(int cachePosition, uint32_t remaining) {
+        if (remaining == 0)
+            return -1.0f; // no triangle left to draw
+        float score = 0.0f;
+        if (cachePosition >= 0) {
+            if (cachePosition < 3)
+                score = LAST_TRIANGLE_SCORE; // the vertices of the last triangle are scored equally, whichever order they had
+            else
+                score = std::pow(1.0f - (cachePosition - 3) / static_cast<float>(SCORE_CACHE_SIZE - 3), CACHE_DECAY_POWER);
+        }
+        return score + VALENCE_BOOST_SCALE * std::pow(static_cast<float>(remaining), -VALENCE_BOOST_POWER);
+    }
+
+    // misses of a FIFO cache, tracked by insertion time so lookups are O(1)
+    class FifoCache {
+    private:
+        std::vector<uint64_t> _inserted;
+        uint64_t _time;
+        uint64_t _size;
+
+    public:
+        FifoCache(size_t vertexCount, unsigned int size) : _inserted(vertexCount, 0), _time(size + 1), _size(size) {}
+
+        void reset() {
+            _time += _size + 1;
+        }
+
+        bool access(uint32_t vertex) {
+            if (_time - _inserted[vertex] <= _size)
+                return false;
+            _inserted[vertex] = _time++;
+            return true;
+        }
+    };
+
+    glm::vec3 position(const unsigned char* vertices, int stride, int positionOffset, uint32_t index) {
+        glm::vec3 result;
+        std::memcpy(&result, vertices + static_cast<size_t>(index) * stride + positionOffset, sizeof(result));
+        return result;
+    }
+}
+
+VertexCacheStats analyzeVertexCache(std::span<const uint32_t> indices, size_t vertexCount, unsigned int cacheSize) {
+    checkTriangles(indices, vertexCount);
+    if (cacheSize == 0)
+        throw std::invalid_argument("cacheSize must be greater than 0!");
+
+    VertexCacheStats stats;
+    stats.triangles = indices.size() / 3;
+    FifoCache cache(vertexCount, cacheSize);
+    std::vector<bool> referenced(vertexCount, false);
+    for (uint32_t index : indices) {
+        if (cache.access(index))
+            stats.transforms++;
+        if (!referenced[index]) {
+            referenced[index] = true;
+            stats.vertices++;
+        }
+    }
+    if (stats.triangles > 0)
+        stats.acmr = static_cast<float>(stats.transforms) / stats.triangles;
+    if (stats.vertices > 0)
+        stats.atvr = static_cast<float>(stats.transforms) / stats.vertices;
+    return stats;
+}
+
+void optimizeVertexCache(std::span<uint32_t> indices, size_t vertexCount) {
+    checkTriangles(indices, vertexCount);
+    size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0)
+        return;
+
+    // triangles of each vertex, the first remaining[v] entries are the ones not emitted yet
+    std::vector<uint32_t> remaining(vertexCount, 0);
+    for (uint32_t index : indices)
+        remaining[index]++;
+    std::vector<uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+    std::inclusive_scan(remaining.begin(), remaining.end(), adjacencyOffsets.begin() + 1);
+    std::vector<uint32_t> adjacency(indices.size());
+    {
+        std::vector<uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+        for (size_t i = 0; i < indices.size(); i++)
+            adjacency[fill[indices[i]]++] = static_cast<uint32_t>(i / 3);
+    }
+
+    std::vector<int> cachePositions(vertexCount, -1);
+    std::vector<float> vertexScores(vertexCount);
+    for (size_t v = 0; v < vertexCount; v++)
+        vertexScores[v] = vertexScore(-1, remaining[v]);
+    std::vector<bool> emitted(triangleCount, false);
+    std::vector<uint32_t> output(indices.size());
+    std::vector<uint32_t> cache, newCache;
+    cache.reserve(SCORE_CACHE_SIZE + 3);
+    newCache.reserve(SCORE_CACHE_SIZE + 3);
+
+    size_t cursor = 0;
+    int64_t best = 0;
+    for (size_t emittedCount = 0; emittedCount < triangleCount; emittedCount++) {
+        if (best < 0) {
+            // nothing in the cache has triangles left, continue with the next triangle in input order
+            while (emitted[cursor])
+                cursor++;
+            best = static_cast<int64_t>(cursor);
+        }
+        const uint32_t* triangle = &indices[static_cast<size_t>(best) * 3];
+        std::copy(triangle, triangle + 3, output.begin() + emittedCount * 3);
+        emitted[static_cast<size_t>(best)] = true;
+
+        newCache.clear();
+        for (int i = 0; i < 3; i++) {
+            uint32_t vertex = triangle[i];
+            uint32_t* first = &adjacency[adjacencyOffsets[vertex]];
+            uint32_t* last = first + remaining[vertex];
+            *std::find(first, last, static_cast<uint32_t>(best)) = *(last - 1);
+            remaining[vertex]--;
+            if (std::find(newCache.begin(), newCache.end(), vertex) == newCache.end())
+                newCache.push_back(vertex);
+        }
+        for (uint32_t vertex : cache)
+            if (std::find(newCache.begin(), newCache.end(), vertex) == newCache.end())
+                newCache.push_back(vertex);
+
+        // rescore the vertices whose cache position changed, including the ones that just got evicted
+        for (size_t i = 0; i < newCache.size(); i++) {
+            uint32_t vertex = newCache[i];
+            cachePositions[vertex] = i < SCORE_CACHE_SIZE ? static_cast<int>(i) : -1;
+            vertexScores[vertex] = vertexScore(cachePositions[vertex], remaining[vertex]);
+        }
+
+        best = -1;
+        float bestScore = -1.0f;
+        if (newCache.size() > SCORE_CACHE_SIZE)
+            newCache.resize(SCORE_CACHE_SIZE);
+        for (uint32_t vertex : newCache) {
+            for (uint32_t j = 0; j < remaining[vertex]; j++) {
+                uint32_t t = adjacency[adjacencyOffsets[vertex] + j];
+                float score = vertexScores[indices[t * 3]] + vertexScores[indices[t * 3 + 1]] + vertexScores[indices[t * 3 + 2]];
+                if (score > bestScore) {
+                    bestScore = score;
+                    best = t;
+                }
+            }
+        }
+        std::swap(cache, newCache);
+    }
+
+    std::copy(output.begin(), output.end(), indices.begin());
+}
+
+void optimizeOverdraw(std::span<uint32_t> indices, const void* vertices, size_t vertexCount, int stride, int positionOffset, float threshold, unsigned int cacheSize) {
+    checkTriangles(indices, vertexCount);
+    if (positionOffset < 0 || stride <= 0 || positionOffset + static_cast<int>(sizeof(glm::vec3)) > stride)
+        throw std::invalid_argument("The position extends over the stride!");
+    if (cacheSize == 0)
+        throw std::invalid_argument("cacheSize must be greater than 0!");
+    size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0)
+        return;
+
+    // hard boundaries where all three vertices miss the cache of the original order
+    std::vector<bool> hard(triangleCount);
+    size_t totalMisses = 0;
+    {
+        FifoCache cache(vertexCount, cacheSize);
+        for (size_t t = 0; t < triangleCount; t++) {
+            int misses = cache.access(indices[t * 3]) + cache.access(indices[t * 3 + 1]) + cache.access(indices[t * 3 + 2]);
+            hard[t] = misses == 3;
+            totalMisses += misses;
+        }
+    }
+    float limit = threshold * static_cast<float>(totalMisses) / triangleCount;
+
+    // soft boundaries where the ACMR of the cluster so far, starting with a cold cache, is good enough
+    std::vector<size_t> clusters; // first triangle of every cluster
+    FifoCache cache(vertexCount, cacheSize);
+    size_t clusterMisses = 0;
+    bool split = true;
+    for (size_t t = 0; t < triangleCount; t++) {
+        if (split || hard[t]) {
+            clusters.push_back(t);
+            cache.reset();
+            clusterMisses = 0;
+        }
+        clusterMisses += cache.access(indices[t * 3]) + cache.access(indices[t * 3 + 1]) + cache.access(indices[t * 3 + 2]);
+        split = static_cast<float>(clusterMisses) <= limit * static_cast<float>(t - clusters.back() + 1);
+    }
+    clusters.push_back(triangleCount);
+
+    // area weighted centroid and normal of each cluster
+    const unsigned char* data = static_cast<const unsigned char*>(vertices);
+    size_t clusterCount = clusters.size() - 1;
+    std::vector<glm::vec3> centroids(clusterCount, glm::vec3(0.0f)), normals(clusterCount, glm::vec3(0.0f));
+    glm::vec3 meshCentroid(0.0f);
+    float meshArea = 0.0f;
+    for (size_t c = 0; c < clusterCount; c++) {
+        float area = 0.0f;
+        for (size_t t = clusters[c]; t < clusters[c + 1]; t++) {
+            glm::vec3 a = position(data, stride, positionOffset, indices[t * 3]);
+            glm::vec3 b = position(data, stride, positionOffset, indices[t * 3 + 1]);
+            glm::vec3 d = position(data, stride, positionOffset, indices[t * 3 + 2]);
+            glm::vec3 normal = glm::cross(b - a, d - a);
+            float weight = glm::length(normal);
+            centroids[c] += (a + b + d) * (weight / 3.0f);
+            normals[c] += normal;
+            area += weight;
+        }
+        meshCentroid += centroids[c];
+        meshArea += area;
+        centroids[c] = area > 0.0f ? centroids[c] / area : position(data, stride, positionOffset, indices[clusters[c] * 3]);
+    }
+    if (meshArea > 0.0f)
+        meshCentroid /= meshArea;
+
+    std::vector<float> sortKeys(clusterCount);
+    for (size_t c = 0; c < clusterCount; c++) {
+        float length = glm::length(normals[c]);
+        sortKeys[c] = length > 0.0f ? glm::dot(centroids[c] - meshCentroid, normals[c] / length) : 0.0f;
+    }
+    std::vector<size_t> order(clusterCount);
+    std::iota(order.begin(), order.end(), size_t(0));
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return sortKeys[a] > sortKeys[b]; });
+
+    std::vector<uint32_t> output;
+    output.reserve(indices.size());
+    for (size_t c : order)
+        output.insert(output.end(), indices.begin() + clusters[c] * 3, indices.begin() + clusters[c + 1] * 3);
+    std::copy(output.begin(), output.end(), indices.begin());
+}
+
+size_t optimizeVertexFetch(std::span<uint32_t> indices, void* vertices, size_t vertexCount, int stride) {
+    if (stride <= 0)
+        throw std::invalid_argument("stride must be greater than 0!");
+    for (uint32_t index : indices)
+        if (index >= vertexCount)
+            throw std::out_of_range("Index is not below the vertex count!");
+
+    std::vector<uint32_t> remap(vertexCount, UNUSED);
+    uint32_t next = 0;
+    for (uint32_t& index : indices) {
+        if (remap[index] == UNUSED)
+            remap[index] = next++;
+        index = remap[index];
+    }
+
+    unsigned char* data = static_cast<unsigned char*>(vertices);
+    size_t size = static_cast<size_t>(stride);
+    std::vector<unsigned char> copy(data, data + vertexCount * size);
+    for (size_t v = 0; v < vertexCount; v++)
+        if (remap[v] != UNUSED)
+            std::memcpy(data + remap[v] * size, copy.data() + v * size, size);
+    return next;
+}
+
+MeshOptimizeReport optimizeMesh(std::span<uint32_t> indices, void* vertices, size_t vertexCount, int stride, const MeshOptimizeOptions& options) {
+    if (stride <= 0)
+        throw std::invalid_argument("stride must be greater than 0!");
+
+    MeshOptimizeReport report;
+    report.before = analyzeVertexCache(indices, vertexCount, options.cacheSize);
+    optimizeVertexCache(indices, vertexCount);
+    if (options.overdraw)
+        optimizeOverdraw(indices, vertices, vertexCount, stride, options.positionOffset, options.overdrawThreshold, options.cacheSize);
+    report.vertices = optimizeVertexFetch(indices, vertices, vertexCount, stride);
+    report.after = analyzeVertexCache(indices, report.vertices, options.cacheSize);
+    return report;
+}
+
+}
@@ -0,0 +1,206 @@
+#include <GLA/offsetAllocator.h>
+
+#include <bit>
+
+namespace gla {
+
+// ----------------------------------------------------------------------------------------------------
+// class OffsetAllocator
+// ----------------------------------------------------------------------------------------------------
+
+// --------------------------------------------------
+// protected methods
+// --------------------------------------------------
+
+void OffsetAllocator::_mapping(int64_t units, uint32_t& fl, uint32_t& sl) {
+    if (units < _SL_COUNT) {
+        fl = 0;
+        sl = static_cast<uint32_t>(units);
+        return;
+    }
+    uint32_t log2 = 63 - std::countl_zero(static_cast<uint64_t>(units));
+    fl = log2 - _SL_LOG2 + 1;
+    sl = static_cast<uint32_t>(units >> (log2 - _SL_LOG2)) - _SL_COUNT;
+}
+
+uint32_t OffsetAllocator::_newNode() {
+    if (!_unusedNodes.empty()) {
+        uint32_t node = _unusedNodes.back();
+        _unusedNodes.pop_back();
+        return node;
+    }
+    _nodes.push_back({});
+    return static_cast<uint32_t>(_nodes.size() - 1);
+}
+
+void OffsetAllocator::_insertFree(uint32_t node) {
+    uint32_t fl, sl;
+    _mapping(_nodes[node].size, fl, sl);
+    uint32_t& head = _bins[fl * _SL_COUNT + sl];
+
+    _nodes[node].used = false;
+    _nodes[node].prevFree = OffsetAllocation::InvalidNode;
+    _nodes[node].nextFree = head;
+    if (head != OffsetAllocation::InvalidNode)
+        _nodes[head].prevFree = node;
+    head = node;
+
+    _slBitmap[fl] |= 1u << sl;
+    _flBitmap |= 1ull << fl;
+    _freeRegions++;
+}
+
+void OffsetAllocator::_removeFree(uint32_t node) {
+    _Node& n = _nodes[node];
+    if (n.prevFree != OffsetAllocation::InvalidNode)
+        _nodes[n.prevFree].nextFree = n.nextFree;
+    if (n.nextFree != OffsetAllocation::InvalidNode)
+        _nodes[n.nextFree].prevFree = n.prevFree;
+
+    uint32_t fl, sl;
+    _mapping(n.size, fl, sl);
+    uint32_t& head = _bins[fl * _SL_COUNT + sl];
+    if (head == node) {
+        head = n.nextFree;
+        if (head == OffsetAllocation::InvalidNode) {
+            _slBitmap[fl] &= ~(1u << sl);
+            if (_slBitmap[fl] == 0)
+                _flBitmap &= ~(1ull << fl);
+        }
+    }
+    _freeRegions--;
+}
+
+uint32_t OffsetAllocator::_findFree(int64_t units) const {
+    // round up to the next size class, so every range in the found bin is big enough
+    if (units >= _SL_COUNT) {
+        uint32_t log2 = 63 - std::countl_zero(static_cast<uint64_t>(units));
+        units += (int64_t(1) << (log2 - _SL_LOG2)) - 1;
+    }
+    uint32_t fl, sl;
+    _mapping(units, fl, sl);
+    if (fl >= _FL_COUNT)
+        return OffsetAllocation::InvalidNode;
+
+    uint32_t slMap = _slBitmap[fl] & (~0u << sl);
+    if (slMap == 0) {
+        if (fl + 1 >= _FL_COUNT)
+            return OffsetAllocation::InvalidNode;
+        uint64_t flMap = _flBitmap & (~0ull << (fl + 1));
+        if (flMap == 0)
+            return OffsetAllocation::InvalidNode;
+        fl = std::countr_zero(flMap);
+        slMap = _slBitmap[fl];
+    }
+    sl = std::countr_zero(slMap);
+    return _bins[fl * _SL_COUNT + sl];
+}
+
+// --------------------------------------------------
+// constructors / destructors
+// --------------------------------------------------
+
+OffsetAllocator::OffsetAllocator(int64_t size, int64_t granularity) : _granularity(granularity), _units(0) {
+    if (granularity <= 0)
+        throw std::invalid_argument("granularity must be greater than 0!");
+    if (size < granularity)
+        throw std::invalid_argument("size must be greater than or equal to granularity!");
+    _units = size / granularity;
+    reset();
+}
+
+// --------------------------------------------------
+// public methods
+// --------------------------------------------------
+
+OffsetAllocation OffsetAllocator::allocate(int64_t size) {
+    if (size <= 0)
+        throw std::invalid_argument("size must be greater than 0!");
+    int64_t units = (size + _granularity - 1) / _granularity;
+
+    uint32_t node = _findFree(units);
+    if (node == OffsetAllocation::InvalidNode)
+        return {};
+    _removeFree(node);
+
+    if (_nodes[node].size > units) {
+        uint32_t rest = _newNode();
+        _Node& n = _nodes[node]; // _newNode may reallocate
+        _nodes[rest] = { n.offset + units, n.size - units, node, n.nextPhys,
+                         OffsetAllocation::InvalidNode, OffsetAllocation::InvalidNode, false };
+        if (n.nextPhys != OffsetAllocation::InvalidNode)
+            _nodes[n.nextPhys].prevPhys = rest;
+        n.nextPhys = rest;
+        n.size = units;
+        _insertFree(rest);
+    }
+
+    _nodes[node].used = true;
+    _usedUnits += units;
+    _allocations++;
+    return { _nodes[node].offset * _granularity, units * _granularity, node };
+}
+
+void OffsetAllocator::free(const OffsetAllocation& allocation) {
+    uint32_t node = allocation.node;
+    if (node >= _nodes.size() || !_nodes[node].used || _nodes[node].offset * _granularity != allocation.offset)
+        throw std::invalid_argument("Allocation is invalid or was already freed!");
+
+    _usedUnits -= _nodes[node].size;
+    _allocations--;
+
+    uint32_t prev = _nodes[node].prevPhys;
+    if (prev != OffsetAllocation::InvalidNode && !_nodes[prev].used) {
+        _removeFree(prev);
+        _nodes[prev].size += _nodes[node].size;
+        _nodes[prev].nextPhys = _nodes[node].nextPhys;
+        if (_nodes[node].nextPhys != OffsetAllocation::InvalidNode)
+            _nodes[_nodes[node].nextPhys].prevPhys = prev;
+        _unusedNodes.push_back(node);
+        node = prev;
+    }
+
+    uint32_t next = _nodes[node].nextPhys;
+    if (next != OffsetAllocation::InvalidNode && !_nodes[next].used) {
+        _removeFree(next);
+        _nodes[node].size += _nodes[next].size;
+        _nodes[node].nextPhys = _nodes[next].nextPhys;
+        if (_nodes[next].nextPhys != OffsetAllocation::InvalidNode)
+            _nodes[_nodes[next].nextPhys].prevPhys = node;
+        _unusedNodes.push_back(next);
+    }
+
+    _insertFree(node);
+}
+
+void OffsetAllocator::reset() {
+    _nodes.clear();
+    _unusedNodes.clear();
+    _usedUnits = 0;
+    _freeRegions = 0;
+    _allocations = 0;
+    _flBitmap = 0;
+    for (uint32_t& map : _slBitmap)
+        map = 0;
+    for (uint32_t& bin : _bins)
+        bin = OffsetAllocation::InvalidNode;
+
+    uint32_t node = _newNode();
+    _nodes[node] = { 0, _units, OffsetAllocation::InvalidNode, OffsetAllocation::InvalidNode,
+                     OffsetAllocation::InvalidNode, OffsetAllocation::InvalidNode, false };
+    _insertFree(node);
+}
+
+int64_t OffsetAllocator::largestFreeRegion() const {
+    if (_flBitmap == 0)
+        return 0;
+    uint32_t fl = 63 - std::countl_zero(_flBitmap);
+    uint32_t sl = 31 - std::countl_zero(_slBitmap[fl]);
+    int64_t largest = 0;
+    for (uint32_t node = _bins[fl * _SL_COUNT + sl]; node != OffsetAllocation::InvalidNode; node = _nodes[node].nextFree)
+        if (_nodes[node].size > largest)
+            largest = _nodes[node].size;
+    return largest * _granularity;
+}
+
+}
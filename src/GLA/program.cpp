@@ -4,6 +4,9 @@
 #include <GLA/shader.h>
 
 #include <GLA/debug.h>
+#include <GLA/deletionQueue.h>
+#include <GLA/memoryTracker.h>
+#include <GLA/stateCache.h>
 
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
@@ -19,15 +22,19 @@ namespace gla {
 // --------------------------------------------------
 
 void Program::_delete() {
-    if (_id != 0)
-        GL_CALL(glDeleteProgram(_id));
+    if (_id != 0) {
+        memoryTracker().objectDestroyed(TrackedObject::Program);
+        _deletionQueue->push(DeletionType::Program, _id);
+    }
     _linked = false;
     _id = 0;
 }
 
-void Program::_check() const {
+void Program::_check() {
     if (_id == 0)
         throw std::runtime_error("Failed to create program object!");
+    _deletionQueue = &deletionQueue();
+    memoryTracker().objectCreated(TrackedObject::Program);
 }
 
 void Program::_ensure() const {
@@ -107,7 +114,7 @@ Program::Program() {
     _check();
 }
 Program::Program(Program&& other)
-    : _id(other._id), _linked(other._linked) {
+    : _id(other._id), _linked(other._linked), _deletionQueue(other._deletionQueue) {
     other._id = 0;
     other._linked = false;
 }
@@ -189,11 +196,11 @@ void Program::bind() const {
     _ensure();
     if (!_linked)
         throw std::runtime_error("Could not bind unlinked Program!");
-    GL_CALL(glUseProgram(_id));
+    StateCache::current().useProgram(_id);
 }
 
 void Program::unbind() {
-    GL_CALL(glUseProgram(0));
+    StateCache::current().useProgram(0);
 }
 
 int Program::getUniformLocation(const std::string& name) const {
@@ -260,6 +267,7 @@ Program& Program::operator=(Program&& other) {
         _delete();
         _id = other._id;
         _linked = other._linked;
+        _deletionQueue = other._deletionQueue;
         other._id = 0;
         other._linked = false;
     }
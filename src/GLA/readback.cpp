@@ -0,0 +1,103 @@
+#include <GLA/readback.h>
+
+#include <chrono>
+
+namespace gla {
+
+// ----------------------------------------------------------------------------------------------------
+// class ReadbackQueue
+// ----------------------------------------------------------------------------------------------------
+
+// --------------------------------------------------
+// protected methods
+// --------------------------------------------------
+
+void ReadbackQueue::_resolveFront() {
+    _Request& request = _inFlight.front();
+    std::vector<char>& data = request.state->data;
+    std::memcpy(data.data(), _data + request.offset, data.size());
+    request.state->ready = true;
+    _stats.completed++;
+    _stats.bytesRead += data.size();
+    _stats.inFlight--;
+    _inFlight.pop_front();
+}
+
+int64_t ReadbackQueue::_reserve(int64_t size, int64_t& begin) {
+    if (size > _capacity)
+        throw std::invalid_argument("size may not be greater than the capacity of the ReadbackQueue!");
+
+    int64_t base = _head - _head % _capacity;
+    int64_t offset = _head % _capacity;
+    if (offset + size > _capacity) {
+        base += _capacity;
+        offset = 0;
+    }
+    int64_t end = base + offset + size;
+
+    // backpressure: wait for the oldest readbacks until there is room
+    poll();
+    while (!_inFlight.empty() && (_inFlight.size() >= _maxInFlight || end - _capacity > _inFlight.front().begin)) {
+        auto start = std::chrono::steady_clock::now();
+        _inFlight.front().fence.wait();
+        _stats.stalls++;
+        _stats.stallMilliseconds += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        _resolveFront();
+    }
+
+    begin = _head;
+    _head = end;
+    return offset;
+}
+
+Readback ReadbackQueue::_submit(int64_t begin, int64_t offset, int64_t size) {
+    Readback readback;
+    readback._state = std::make_shared<Readback::_State>();
+    readback._state->data.resize(size);
+
+    _Request request = { Fence(), begin, offset, readback._state };
+    request.fence.insert();
+    _inFlight.push_back(std::move(request));
+
+    _stats.requests++;
+    _stats.inFlight++;
+    if (_stats.inFlight > _stats.peakInFlight)
+        _stats.peakInFlight = _stats.inFlight;
+    return readback;
+}
+
+// --------------------------------------------------
+// constructors / destructors
+// --------------------------------------------------
+
+ReadbackQueue::ReadbackQueue(int64_t capacity, uint32_t maxInFlight)
+    : _staging(BufferType::CopyWrite), _capacity(capacity), _maxInFlight(maxInFlight) {
+    if (capacity <= 0)
+        throw std::invalid_argument("capacity must be greater than 0!");
+    if (maxInFlight == 0)
+        throw std::invalid_argument("maxInFlight must be greater than 0!");
+    _staging.setStorage(capacity, nullptr, BufferFlag::MapRead | BufferFlag::MapPersistent | BufferFlag::MapCoherent);
+    _data = static_cast<const char*>(_staging.map(0, capacity, MapUsage::Read | MapUsage::Persistent | MapUsage::Coherent));
+}
+
+// --------------------------------------------------
+// public methods
+// --------------------------------------------------
+
+uint32_t ReadbackQueue::poll() {
+    uint32_t resolved = 0;
+    while (!_inFlight.empty() && _inFlight.front().fence.signaled()) {
+        _resolveFront();
+        resolved++;
+    }
+    return resolved;
+}
+
+void ReadbackQueue::finish() {
+    while (!_inFlight.empty()) {
+        _inFlight.front().fence.wait();
+        _resolveFront();
+    }
+}
+
+}
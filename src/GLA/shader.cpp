@@ -6,6 +6,8 @@
 #include <GLA/program.h>
 
 #include <GLA/debug.h>
+#include <GLA/deletionQueue.h>
+#include <GLA/memoryTracker.h>
 
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
@@ -45,8 +47,10 @@ unsigned int toGLenum(ShaderType type) {
 // --------------------------------------------------
 
 void Shader::_delete() {
-    if (_id != 0)
-        GL_CALL(glDeleteShader(_id));
+    if (_id != 0) {
+        memoryTracker().objectDestroyed(TrackedObject::Shader);
+        _deletionQueue->push(DeletionType::Shader, _id);
+    }
     _compiled = false;
     _id = 0;
 }
@@ -54,6 +58,8 @@ void Shader::_delete() {
 void Shader::_check() {
     if (_id == 0)
         throw std::runtime_error("Failed to create shader object!");
+    _deletionQueue = &deletionQueue();
+    memoryTracker().objectCreated(TrackedObject::Shader);
 }
 
 void Shader::_ensure() {
@@ -100,7 +106,7 @@ Shader::Shader(ShaderType type, std::istream&& in) : _type(type) {
     compile(in);
 }
 
-Shader::Shader(Shader&& other) : _id(other._id), _type(other._type), _compiled(other._compiled) { other._id = 0; other._compiled = false; }
+Shader::Shader(Shader&& other) : _id(other._id), _type(other._type), _compiled(other._compiled), _deletionQueue(other._deletionQueue) { other._id = 0; other._compiled = false; }
 
 Shader::~Shader() noexcept { _delete(); }
 
@@ -168,6 +174,7 @@ Shader& Shader::operator=(Shader&& other) {
         _id = other._id;
         _type = other._type;
         _compiled = other._compiled;
+        _deletionQueue = other._deletionQueue;
         other._id = 0;
         other._compiled = false;
     }
@@ -0,0 +1,125 @@
+#include <GLA/sparseBuffer.h>
+
+#include <GLA/capabilities.h>
+
+namespace gla {
+
+// ----------------------------------------------------------------------------------------------------
+// class SparseBuffer
+// ----------------------------------------------------------------------------------------------------
+
+// --------------------------------------------------
+// protected methods
+// --------------------------------------------------
+
+void SparseBuffer::_pageRange(int64_t offset, int64_t size, int64_t& first, int64_t& last) const {
+    if (offset < 0)
+        throw std::runtime_error("offset may not be negative!");
+    if (size <= 0)
+        throw std::runtime_error("size must be greater than 0!");
+    if (offset + size > _size)
+        throw std::runtime_error("size + offset may not be greater than size()!");
+    first = offset / _pageSize;
+    last = (offset + size - 1) / _pageSize;
+}
+
+void SparseBuffer::_setResidency(int64_t first, int64_t last, bool commit) {
+    for (int64_t page = first; page <= last; page++) {
+        uint64_t bit = uint64_t(1) << (page % 64);
+        if (commit)
+            _residency[page / 64] |= bit;
+        else
+            _residency[page / 64] &= ~bit;
+    }
+}
+
+// --------------------------------------------------
+// constructors / destructors
+// --------------------------------------------------
+
+SparseBuffer::SparseBuffer(BufferType type, int64_t size, int64_t fallbackPageSize)
+    : _type(type), _sparse(capabilities().sparseBuffer), _buffer(type) {
+    if (size <= 0)
+        throw std::invalid_argument("size must be greater than 0!");
+    if (fallbackPageSize <= 0)
+        throw std::invalid_argument("fallbackPageSize must be greater than 0!");
+    _pageSize = _sparse ? capabilities().sparseBufferPageSize : fallbackPageSize;
+    _size = (size + _pageSize - 1) / _pageSize * _pageSize;
+    int64_t pages = _size / _pageSize;
+    _residency.resize((pages + 63) / 64, 0);
+    if (_sparse)
+        _buffer.setStorage(_size, nullptr, BufferFlag::Sparse | BufferFlag::DynamicStorage);
+    else
+        _pages.resize(pages);
+}
+
+// --------------------------------------------------
+// public methods
+// --------------------------------------------------
+
+void SparseBuffer::commit(int64_t offset, int64_t size) {
+    int64_t first, last;
+    _pageRange(offset, size, first, last);
+    for (int64_t page = first; page <= last; page++) {
+        if (_resident(page))
+            continue;
+        // commit runs of missing pages with one call
+        int64_t end = page;
+        while (end + 1 <= last && !_resident(end + 1))
+            end++;
+        if (_sparse) {
+            _buffer.commitPages(page * _pageSize, (end - page + 1) * _pageSize, true);
+        } else {
+            for (int64_t p = page; p <= end; p++) {
+                _pages[p] = std::make_unique<Buffer>(_type);
+                _pages[p]->setStorage(_pageSize, nullptr, BufferFlag::DynamicStorage);
+            }
+        }
+        _setResidency(page, end, true);
+        _committedPages += end - page + 1;
+        page = end;
+    }
+}
+
+void SparseBuffer::decommit(int64_t offset, int64_t size) {
+    int64_t first, last;
+    _pageRange(offset, size, first, last);
+    for (int64_t page = first; page <= last; page++) {
+        if (!_resident(page))
+            continue;
+        int64_t end = page;
+        while (end + 1 <= last && _resident(end + 1))
+            end++;
+        if (_sparse) {
+            _buffer.commitPages(page * _pageSize, (end - page + 1) * _pageSize, false);
+        } else {
+            for (int64_t p = page; p <= end; p++)
+                _pages[p].reset();
+        }
+        _setResidency(page, end, false);
+        _committedPages -= end - page + 1;
+        page = end;
+    }
+}
+
+bool SparseBuffer::resident(int64_t offset, int64_t size) const {
+    int64_t first, last;
+    _pageRange(offset, size, first, last);
+    for (int64_t page = first; page <= last; page++)
+        if (!_resident(page))
+            return false;
+    return true;
+}
+
+BufferSlice SparseBuffer::locate(int64_t offset, int64_t size) {
+    if (!resident(offset, size))
+        throw std::runtime_error("Range is not resident, commit it first!");
+    if (_sparse)
+        return { &_buffer, offset, size, 0 };
+    int64_t page = offset / _pageSize;
+    if ((offset + size - 1) / _pageSize != page)
+        throw std::runtime_error("Range crosses a page boundary of the non-sparse fallback!");
+    return { _pages[page].get(), offset - page * _pageSize, size, 0 };
+}
+
+}
@@ -0,0 +1,172 @@
+#include <GLA/stateCache.h>
+
+#include <GLA/capabilities.h>
+#include <GLA/debug.h>
+
+#include <GL/glew.h>
+
+namespace gla {
+
+namespace {
+    thread_local StateCache* currentCache = nullptr;
+    thread_local StateCache fallbackCache;
+}
+
+// ----------------------------------------------------------------------------------------------------
+// class StateCache
+// ----------------------------------------------------------------------------------------------------
+
+// --------------------------------------------------
+// protected methods
+// --------------------------------------------------
+
+bool StateCache::_setIndexed(BufferType type, unsigned int index, unsigned int id, int64_t offset, int64_t size, bool generic) {
+    std::vector<_IndexedBinding>& bindings = _indexed[static_cast<int>(type)];
+    if (index >= bindings.size())
+        bindings.resize(index + 1, { _UNKNOWN, 0, -1 });
+    _IndexedBinding& binding = bindings[index];
+
+    // glBindBufferBase / glBindBufferRange also bind the Buffer to the generic binding point, the multi-bind calls don't
+    unsigned int& genericId = _buffers[static_cast<int>(type)];
+    if (binding.id == id && binding.offset == offset && binding.size == size && (!generic || genericId == id))
+        return false;
+    binding = { id, offset, size };
+    if (generic)
+        genericId = id;
+    return true;
+}
+
+// --------------------------------------------------
+// constructors / destructors
+// --------------------------------------------------
+
+StateCache::StateCache() {
+    invalidate();
+}
+
+// --------------------------------------------------
+// public methods
+// --------------------------------------------------
+
+StateCache& StateCache::current() {
+    return currentCache ? *currentCache : fallbackCache;
+}
+
+void StateCache::makeCurrent(StateCache* cache) {
+    currentCache = cache;
+}
+
+bool StateCache::isCurrent(const StateCache* cache) {
+    return currentCache == cache;
+}
+
+void StateCache::useProgram(unsigned int id) {
+    if (_program == id) {
+        _stats.elided++;
+        return;
+    }
+    GL_CALL(glUseProgram(id));
+    _program = id;
+    _stats.issued++;
+}
+
+void StateCache::bindVertexArray(unsigned int id) {
+    if (_vertexArray == id) {
+        _stats.elided++;
+        return;
+    }
+    GL_CALL(glBindVertexArray(id));
+    _vertexArray = id;
+    _buffers[static_cast<int>(BufferType::ElementArray)] = _UNKNOWN; // the element array binding is part of the VAO
+    _stats.issued++;
+}
+
+unsigned int StateCache::vertexArray() {
+    if (_vertexArray == _UNKNOWN) {
+        GLint id = 0;
+        GL_CALL(glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &id));
+        _vertexArray = static_cast<unsigned int>(id);
+    }
+    return _vertexArray;
+}
+
+void StateCache::bindBuffer(BufferType type, unsigned int id) {
+    unsigned int& bound = _buffers[static_cast<int>(type)];
+    if (bound == id) {
+        _stats.elided++;
+        return;
+    }
+    GL_CALL(glBindBuffer(toGLenum(type), id));
+    bound = id;
+    _stats.issued++;
+}
+
+void StateCache::bindBufferBase(BufferType type, unsigned int index, unsigned int id) {
+    if (!_setIndexed(type, index, id, 0, -1, true)) {
+        _stats.elided++;
+        return;
+    }
+    GL_CALL(glBindBufferBase(toGLenum(type), index, id));
+    _stats.issued++;
+}
+
+void StateCache::bindBufferRange(BufferType type, unsigned int index, unsigned int id, int64_t offset, int64_t size) {
+    if (!_setIndexed(type, index, id, offset, size, true)) {
+        _stats.elided++;
+        return;
+    }
+    GL_CALL(glBindBufferRange(toGLenum(type), index, id, offset, size));
+    _stats.issued++;
+}
+
+void StateCache::bindBuffersRange(BufferType type, unsigned int first, std::span<const unsigned int> ids, std::span<const int64_t> offsets, std::span<const int64_t> sizes) {
+    if (!capabilities().multiBind) {
+        for (size_t i = 0; i < ids.size(); i++)
+            bindBufferRange(type, first + static_cast<unsigned int>(i), ids[i], offsets[i], sizes[i]);
+        return;
+    }
+    bool changed = false;
+    for (size_t i = 0; i < ids.size(); i++)
+        changed |= _setIndexed(type, first + static_cast<unsigned int>(i), ids[i], offsets[i], sizes[i], false);
+    if (!changed) {
+        _stats.elided++;
+        return;
+    }
+    std::vector<GLintptr> glOffsets(offsets.begin(), offsets.end());
+    std::vector<GLsizeiptr> glSizes(sizes.begin(), sizes.end());
+    GL_CALL(glBindBuffersRange(toGLenum(type), first, static_cast<GLsizei>(ids.size()), ids.data(), glOffsets.data(), glSizes.data()));
+    _stats.issued++;
+}
+
+void StateCache::invalidate() {
+    _program = _UNKNOWN;
+    _vertexArray = _UNKNOWN;
+    for (unsigned int& id : _buffers)
+        id = _UNKNOWN;
+    for (std::vector<_IndexedBinding>& bindings : _indexed)
+        bindings.clear();
+}
+
+void StateCache::forgetProgram(unsigned int id) {
+    if (_program == id)
+        _program = _UNKNOWN;
+}
+
+void StateCache::forgetVertexArray(unsigned int id) {
+    if (_vertexArray == id) {
+        _vertexArray = _UNKNOWN;
+        _buffers[static_cast<int>(BufferType::ElementArray)] = _UNKNOWN;
+    }
+}
+
+void StateCache::forgetBuffer(unsigned int id) {
+    for (unsigned int& bound : _buffers)
+        if (bound == id)
+            bound = _UNKNOWN;
+    for (std::vector<_IndexedBinding>& bindings : _indexed)
+        for (_IndexedBinding& binding : bindings)
+            if (binding.id == id)
+                binding.id = _UNKNOWN;
+}
+
+}
@@ -0,0 +1,112 @@
+#include <GLA/streamingBuffer.h>
+
+#include <chrono>
+
+namespace gla {
+
+// ----------------------------------------------------------------------------------------------------
+// class StreamingBuffer
+// ----------------------------------------------------------------------------------------------------
+
+// --------------------------------------------------
+// protected methods
+// --------------------------------------------------
+
+void StreamingBuffer::_waitUntilFree(int64_t position) {
+    while (!_regions.empty() && _regions.front().begin < position) {
+        _Region& region = _regions.front();
+        if (!region.fence.signaled()) {
+            auto start = std::chrono::steady_clock::now();
+            region.fence.wait();
+            _stats.stalls++;
+            _stats.stallMilliseconds += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+        _regions.pop_front();
+    }
+}
+
+// --------------------------------------------------
+// constructors / destructors
+// --------------------------------------------------
+
+StreamingBuffer::StreamingBuffer(BufferType type, int64_t capacity) : _buffer(type), _capacity(capacity) {
+    if (capacity <= 0)
+        throw std::invalid_argument("capacity must be greater than 0!");
+    _buffer.setStorage(capacity, nullptr, BufferFlag::MapWrite | BufferFlag::MapPersistent | BufferFlag::MapCoherent);
+    _data = static_cast<char*>(_buffer.map(0, capacity, MapUsage::Write | MapUsage::Persistent | MapUsage::Coherent));
+}
+
+StreamingBuffer::StreamingBuffer(StreamingBuffer&& other)
+    : _buffer(std::move(other._buffer)), _data(other._data), _capacity(other._capacity), _head(other._head),
+      _fencedEnd(other._fencedEnd), _regions(std::move(other._regions)), _stats(other._stats) {
+    other._data = nullptr;
+    other._capacity = 0;
+    other._head = 0;
+    other._fencedEnd = 0;
+    other._regions.clear();
+}
+
+// --------------------------------------------------
+// public methods
+// --------------------------------------------------
+
+StreamingAllocation StreamingBuffer::allocate(int64_t size, int64_t alignment) {
+    if (size <= 0)
+        throw std::invalid_argument("size must be greater than 0!");
+    if (size > _capacity)
+        throw std::invalid_argument("size may not be greater than capacity()!");
+    if (alignment <= 0 || (alignment & (alignment - 1)) != 0)
+        throw std::invalid_argument("alignment must be a power of two!");
+
+    int64_t base = _head - _head % _capacity;
+    int64_t offset = (_head % _capacity + alignment - 1) & ~(alignment - 1);
+    if (offset + size > _capacity) {
+        base += _capacity;
+        offset = 0;
+        _stats.wraps++;
+    }
+    int64_t end = base + offset + size;
+
+    if (end - _capacity > _fencedEnd)
+        throw std::runtime_error("StreamingBuffer allocation would overwrite data of the current frame, the capacity is too small!");
+    _waitUntilFree(end - _capacity);
+
+    _head = end;
+    _stats.allocations++;
+    _stats.bytesAllocated += size;
+    return { offset, size, _data + offset };
+}
+
+void StreamingBuffer::fence() {
+    if (_head == _fencedEnd)
+        return;
+    _Region region = { Fence(), _fencedEnd, _head };
+    region.fence.insert();
+    _regions.push_back(std::move(region));
+    _fencedEnd = _head;
+    _stats.fences++;
+}
+
+// --------------------------------------------------
+// operator overloads
+// --------------------------------------------------
+
+StreamingBuffer& StreamingBuffer::operator=(StreamingBuffer&& other) {
+    if (this != &other) {
+        _buffer = std::move(other._buffer);
+        _data = other._data;
+        _capacity = other._capacity;
+        _head = other._head;
+        _fencedEnd = other._fencedEnd;
+        _regions = std::move(other._regions);
+        _stats = other._stats;
+        other._data = nullptr;
+        other._capacity = 0;
+        other._head = 0;
+        other._fencedEnd = 0;
+        other._regions.clear();
+    }
+    return *this;
+}
+
+}
@@ -0,0 +1,74 @@
+#include <GLA/uniformArena.h>
+
+#include <GLA/capabilities.h>
+
+#include <algorithm>
+#include <chrono>
+
+namespace gla {
+
+// ----------------------------------------------------------------------------------------------------
+// class UniformArena
+// ----------------------------------------------------------------------------------------------------
+
+// --------------------------------------------------
+// constructors / destructors
+// --------------------------------------------------
+
+UniformArena::UniformArena(int64_t frameSize, uint32_t frames) : _buffer(BufferType::Uniform), _frameSize(frameSize) {
+    if (frameSize <= 0)
+        throw std::invalid_argument("frameSize must be greater than 0!");
+    if (frames == 0)
+        throw std::invalid_argument("frames must be greater than 0!");
+    // keep every segment aligned for both targets
+    int64_t alignment = std::max(capabilities().uniformBufferOffsetAlignment, capabilities().shaderStorageBufferOffsetAlignment);
+    _frameSize = (frameSize + alignment - 1) / alignment * alignment;
+    _fences.resize(frames);
+    int64_t capacity = _frameSize * frames;
+    _buffer.setStorage(capacity, nullptr, BufferFlag::MapWrite | BufferFlag::MapPersistent | BufferFlag::MapCoherent);
+    _data = static_cast<char*>(_buffer.map(0, capacity, MapUsage::Write | MapUsage::Persistent | MapUsage::Coherent));
+}
+
+// --------------------------------------------------
+// public methods
+// --------------------------------------------------
+
+BufferSlice UniformArena::allocate(int64_t size, BufferType type) {
+    int64_t alignment;
+    if (type == BufferType::Uniform)
+        alignment = capabilities().uniformBufferOffsetAlignment;
+    else if (type == BufferType::ShaderStorage)
+        alignment = capabilities().shaderStorageBufferOffsetAlignment;
+    else
+        throw std::logic_error("UniformArena only serves BufferType::Uniform and BufferType::ShaderStorage!");
+    if (size <= 0)
+        throw std::invalid_argument("size must be greater than 0!");
+
+    int64_t offset = (_head + alignment - 1) / alignment * alignment;
+    if (offset + size > _frameSize)
+        throw std::runtime_error("UniformArena is out of memory for this frame, the frame size is too small!");
+    _head = offset + size;
+
+    _stats.allocations++;
+    _stats.bytesAllocated += size;
+    if (_head > _stats.peakFrameBytes)
+        _stats.peakFrameBytes = _head;
+    return { &_buffer, _frame * _frameSize + offset, size, 0 };
+}
+
+void UniformArena::endFrame() {
+    _fences[_frame].insert();
+    _frame = (_frame + 1) % static_cast<uint32_t>(_fences.size());
+    _head = 0;
+
+    Fence& next = _fences[_frame];
+    if (!next.signaled()) {
+        auto start = std::chrono::steady_clock::now();
+        next.wait();
+        _stats.stalls++;
+        _stats.stallMilliseconds += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+    next.reset();
+}
+
+}
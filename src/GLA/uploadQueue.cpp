@@ -0,0 +1,166 @@
+#include <GLA/uploadQueue.h>
+
+#include <algorithm>
+#include <chrono>
+
+namespace gla {
+
+// ----------------------------------------------------------------------------------------------------
+// class UploadQueue
+// ----------------------------------------------------------------------------------------------------
+
+// --------------------------------------------------
+// protected methods
+// --------------------------------------------------
+
+void UploadQueue::_retire(int64_t begin, int64_t end) {
+    _retired[begin] = end;
+}
+
+void UploadQueue::_advanceTail() {
+    // spans tile the monotonic range without gaps, so the tail moves over every retired span that starts at it
+    int64_t tail = _tail.load(std::memory_order_relaxed);
+    for (auto it = _retired.find(tail); it != _retired.end(); it = _retired.find(tail)) {
+        tail = it->second;
+        _retired.erase(it);
+    }
+    _tail.store(tail, std::memory_order_release);
+}
+
+// --------------------------------------------------
+// constructors / destructors
+// --------------------------------------------------
+
+UploadQueue::UploadQueue(int64_t capacity) : _staging(BufferType::CopyRead), _capacity(capacity) {
+    if (capacity <= 0)
+        throw std::invalid_argument("capacity must be greater than 0!");
+    _staging.setStorage(capacity, nullptr, BufferFlag::MapWrite | BufferFlag::MapPersistent | BufferFlag::MapCoherent);
+    _data = static_cast<char*>(_staging.map(0, capacity, MapUsage::Write | MapUsage::Persistent | MapUsage::Coherent));
+}
+
+// --------------------------------------------------
+// public methods
+// --------------------------------------------------
+
+UploadReservation UploadQueue::reserve(int64_t size, int64_t alignment) {
+    if (size <= 0)
+        throw std::invalid_argument("size must be greater than 0!");
+    if (size > _capacity)
+        throw std::invalid_argument("size may not be greater than the capacity of the UploadQueue!");
+    if (alignment <= 0)
+        throw std::invalid_argument("alignment must be greater than 0!");
+
+    int64_t head = _head.load(std::memory_order_relaxed);
+    int64_t offset, end;
+    do {
+        int64_t base = head - head % _capacity;
+        offset = (head % _capacity + alignment - 1) / alignment * alignment;
+        if (offset + size > _capacity) {
+            base += _capacity;
+            offset = 0;
+        }
+        end = base + offset + size;
+        if (end - _capacity > _tail.load(std::memory_order_acquire)) {
+            _failedReservations.fetch_add(1, std::memory_order_relaxed);
+            return {};
+        }
+    } while (!_head.compare_exchange_weak(head, end, std::memory_order_relaxed));
+
+    _reservations.fetch_add(1, std::memory_order_relaxed);
+    _bytesReserved.fetch_add(size, std::memory_order_relaxed);
+    return { _data + offset, offset, size, head, end };
+}
+
+void UploadQueue::submit(UploadReservation& reservation, Buffer& dst, int64_t dstOffset) {
+    if (!reservation.valid())
+        throw std::logic_error("UploadReservation is invalid!");
+    if (dstOffset < 0)
+        throw std::runtime_error("dstOffset may not be negative!");
+    if (dstOffset + reservation.size > dst.size())
+        throw std::runtime_error("size + dstOffset may not be greater than the size of the destination Buffer!");
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _submitted.push_back({ reservation.begin, reservation.end, &dst, reservation.offset, dstOffset, reservation.size });
+    }
+    reservation = {};
+}
+
+void UploadQueue::cancel(UploadReservation& reservation) {
+    if (!reservation.valid())
+        throw std::logic_error("UploadReservation is invalid!");
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _submitted.push_back({ reservation.begin, reservation.end, nullptr, 0, 0, 0 });
+    }
+    reservation = {};
+}
+
+void UploadQueue::flush() {
+    auto start = std::chrono::steady_clock::now();
+
+    while (!_batches.empty() && _batches.front().fence.signaled()) {
+        for (const auto& [begin, end] : _batches.front().spans)
+            _retire(begin, end);
+        _batches.pop_front();
+    }
+
+    std::vector<_Submission> submissions;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        submissions.swap(_submitted);
+    }
+    // keep the reservation order, so uploads into the same range land in the order they were reserved
+    std::sort(submissions.begin(), submissions.end(), [](const _Submission& a, const _Submission& b) { return a.begin < b.begin; });
+
+    _Batch batch;
+    std::vector<BufferCopyRegion> regions;
+    Buffer* dst = nullptr;
+    for (const _Submission& submission : submissions) {
+        if (submission.dst == nullptr) {
+            _retire(submission.begin, submission.end);
+            _stats.cancelled++;
+            continue;
+        }
+        if (submission.dst != dst) {
+            if (!regions.empty())
+                dst->copyFrom(_staging, regions);
+            regions.clear();
+            dst = submission.dst;
+        }
+        regions.push_back({ submission.srcOffset, submission.dstOffset, submission.size });
+        batch.spans.emplace_back(submission.begin, submission.end);
+        _stats.uploads++;
+        _stats.bytesUploaded += submission.size;
+    }
+    if (!regions.empty())
+        dst->copyFrom(_staging, regions);
+    if (!batch.spans.empty()) {
+        batch.fence.insert();
+        _batches.push_back(std::move(batch));
+    }
+
+    _advanceTail();
+    _stats.flushes++;
+    _stats.lastFlushMicroseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+void UploadQueue::finish() {
+    flush();
+    while (!_batches.empty()) {
+        _batches.front().fence.wait();
+        for (const auto& [begin, end] : _batches.front().spans)
+            _retire(begin, end);
+        _batches.pop_front();
+    }
+    _advanceTail();
+}
+
+UploadQueueStats UploadQueue::stats() const {
+    UploadQueueStats stats = _stats;
+    stats.reservations = _reservations.load(std::memory_order_relaxed);
+    stats.failedReservations = _failedReservations.load(std::memory_order_relaxed);
+    stats.bytesReserved = _bytesReserved.load(std::memory_order_relaxed);
+    return stats;
+}
+
+}
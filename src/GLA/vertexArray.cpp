@@ -1,5 +1,7 @@
 #include <GLA/vertexArray.h>
 
+#include <GLA/capabilities.h>
+
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
 
@@ -18,70 +20,25 @@ unsigned int toGLenum(VertexAttribType type) {
     case VertexAttribType::Float:           return GL_FLOAT;
     case VertexAttribType::Double:          return GL_DOUBLE;
     case VertexAttribType::Fixed:           return GL_FIXED;
+    case VertexAttribType::Int2101010Rev:           return GL_INT_2_10_10_10_REV;
+    case VertexAttribType::UnsignedInt2101010Rev:   return GL_UNSIGNED_INT_2_10_10_10_REV;
+    case VertexAttribType::UnsignedInt10F11F11FRev: return GL_UNSIGNED_INT_10F_11F_11F_REV;
     }
     throw std::invalid_argument("Given VertexAttribType is invalid!");
 }
 
-bool validateTypeInterpretation(VertexAttribType type, VertexAttribInterp interp, std::string& error) {
-    if (interp == VertexAttribInterp::Integer) {
-        switch (type) {
-        case VertexAttribType::HalfFloat: error = "Can't use type HalfFloat with Integer interpretation!"; return false;
-        case VertexAttribType::Float: error = "Can't use type Float with Integer interpretation!"; return false;          
-        case VertexAttribType::Double: error = "Can't use type Double with Integer interpretation!"; return false;         
-        case VertexAttribType::Fixed: error = "Can't use type Fixed with Integer interpretation!"; return false;          
-        }
-    }
-    return true;
-}
-
-int typeToBytes(VertexAttribType type) {
-    switch (type)
-    {
-    case VertexAttribType::Byte:            return 1;
-    case VertexAttribType::UnsignedByte:    return 1;
-    case VertexAttribType::Short:           return 2;
-    case VertexAttribType::UnsignedShort:   return 2;
-    case VertexAttribType::Int:             return 4;
-    case VertexAttribType::UnsignedInt:     return 4;
-    case VertexAttribType::HalfFloat:       return 2;
-    case VertexAttribType::Float:           return 4;
-    case VertexAttribType::Double:          return 8;
-    case VertexAttribType::Fixed:           return 4;
-    }
-    throw std::invalid_argument("Given VertexAttribType is invalid!");
-}
-
-// ----------------------------------------------------------------------------------------------------
-// VertexArray class
-// ----------------------------------------------------------------------------------------------------
-
-// --------------------------------------------------
-// public methods
-// --------------------------------------------------
-
-void VertexArray::setAttributes(const std::vector<VertexAttribute>& attribs, int stride) {
+void validateVertexAttributes(const std::vector<VertexAttribute>& attribs, int stride) {
     if (stride <= 0)
         throw std::invalid_argument("stride must be greater than 0!");
 
-    int maxVertexAttribs = -1;
-    GL_CALL(glGetIntegerv(GL_MAX_VERTEX_ATTRIBS, &maxVertexAttribs));
-    if (maxVertexAttribs < 0)
-        throw std::runtime_error("Could not query GL_MAX_VERTEX_ATTRIBS!");
+    int maxVertexAttribs = capabilities().maxVertexAttribs;
     if (maxVertexAttribs < attribs.size())
         throw std::runtime_error("The current GPU does not support " + std::to_string(attribs.size()) + " vertex attributes. Max allowed are: " + std::to_string(maxVertexAttribs) + ". At least 16 are guaranteed!");
 
-    bind();
-
-    for (unsigned int i : _enabledVertexAttribs)
-        GL_CALL(glDisableVertexAttribArray(i));
-
-    _enabledVertexAttribs.clear();
-    _enabledVertexAttribs.reserve(attribs.size());
-
     DEBUG_ONLY(
     
     for (size_t i = 0; i < attribs.size(); i++) {
-        size_t end = attribs[i].offset + typeToBytes(attribs[i].type) * attribs[i].numComponents;
+        size_t end = attribs[i].offset + attributeBytes(attribs[i].type, attribs[i].numComponents);
         if (end > stride)
             throw std::invalid_argument("Given VertexAttributes are bigger than the stride!");
         for (size_t j = 0; j < attribs.size(); j++) {
@@ -97,17 +54,39 @@ void VertexArray::setAttributes(const std::vector<VertexAttribute>& attribs, int
         if (attrib.offset < 0)
             throw std::invalid_argument("Offset may not be less than 0!");
         if (attrib.index >= maxVertexAttribs)
-            throw std::invalid_argument("The current GPU does not support indexes over " + std::to_string(attribs.size()) + "!");
+            throw std::invalid_argument("The current GPU does not support indexes over " + std::to_string(maxVertexAttribs - 1) + "!");
         if (attrib.numComponents > 4 || attrib.numComponents <= 0)
             throw std::invalid_argument("numComponents of VertexAttribute may only be 1 to 4!");
-
-        GL_CALL(glEnableVertexAttribArray(attrib.index));
-        _enabledVertexAttribs.push_back(attrib.index);
+        if (!validateTypeComponents(attrib.type, attrib.numComponents))
+            throw std::invalid_argument("Packed VertexAttribTypes need 4 components (2_10_10_10) or 3 components (10F_11F_11F)!");
 
         std::string error;
         if (!validateTypeInterpretation(attrib.type, attrib.interp, error))
             throw std::invalid_argument(error);
-        
+    }
+}
+
+// ----------------------------------------------------------------------------------------------------
+// VertexArray class
+// ----------------------------------------------------------------------------------------------------
+
+// --------------------------------------------------
+// private methods
+// --------------------------------------------------
+
+void VertexArray::_setAttributes(std::span<const VertexAttribute> attribs, int stride) {
+    bind();
+
+    for (unsigned int i : _enabledVertexAttribs)
+        GL_CALL(glDisableVertexAttribArray(i));
+
+    _enabledVertexAttribs.clear();
+    _enabledVertexAttribs.reserve(attribs.size());
+
+    for (const VertexAttribute& attrib : attribs) {
+        GL_CALL(glEnableVertexAttribArray(attrib.index));
+        _enabledVertexAttribs.push_back(attrib.index);
+
         if (attrib.interp == VertexAttribInterp::Integer)
             GL_CALL(glVertexAttribIPointer(attrib.index, attrib.numComponents, toGLenum(attrib.type), stride, (void*)attrib.offset));
         else
@@ -115,4 +94,13 @@ void VertexArray::setAttributes(const std::vector<VertexAttribute>& attribs, int
     }
 }
 
+// --------------------------------------------------
+// public methods
+// --------------------------------------------------
+
+void VertexArray::setAttributes(const std::vector<VertexAttribute>& attribs, int stride) {
+    validateVertexAttributes(attribs, stride);
+    _setAttributes(attribs, stride);
+}
+
 }
\ No newline at end of file
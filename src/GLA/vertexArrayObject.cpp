@@ -0,0 +1,206 @@
+#include <GLA/vertexArrayObject.h>
+
+#include <GLA/capabilities.h>
+#include <GLA/debug.h>
+#include <GLA/deletionQueue.h>
+#include <GLA/memoryTracker.h>
+#include <GLA/stateCache.h>
+
+#include <GL/glew.h>
+
+#include <string>
+
+namespace gla {
+
+// ----------------------------------------------------------------------------------------------------
+// class VertexArrayObject
+// ----------------------------------------------------------------------------------------------------
+
+// --------------------------------------------------
+// protected methods
+// --------------------------------------------------
+
+void VertexArrayObject::_delete() {
+    if (_id != 0) {
+        memoryTracker().objectDestroyed(TrackedObject::VertexArray);
+        _deletionQueue->push(DeletionType::VertexArray, _id);
+    }
+    _id = 0;
+}
+
+void VertexArrayObject::_check() {
+    if (_id == 0)
+        throw std::runtime_error("Failed to create vertex array object!");
+    _deletionQueue = &deletionQueue();
+    memoryTracker().objectCreated(TrackedObject::VertexArray);
+}
+
+int VertexArrayObject::_stride(unsigned int binding) const {
+    if (binding >= _strides.size() || _strides[binding] == 0)
+        throw std::logic_error("Binding " + std::to_string(binding) + " is not a stream of the VertexLayout!");
+    return _strides[binding];
+}
+
+void VertexArrayObject::_setVertexBuffer(const Buffer& buffer, std::span<const VertexAttribute> attribs, int stride, int64_t offset, unsigned int binding) {
+    if (capabilities().directStateAccess) {
+        GL_CALL(glVertexArrayVertexBuffer(_id, binding, buffer._id, offset, stride));
+        for (const VertexAttribute& attrib : attribs) {
+            GL_CALL(glEnableVertexArrayAttrib(_id, attrib.index));
+            if (attrib.interp == VertexAttribInterp::Integer)
+                GL_CALL(glVertexArrayAttribIFormat(_id, attrib.index, attrib.numComponents, toGLenum(attrib.type), attrib.offset));
+            else
+                GL_CALL(glVertexArrayAttribFormat(_id, attrib.index, attrib.numComponents, toGLenum(attrib.type), attrib.normalized, attrib.offset));
+            GL_CALL(glVertexArrayAttribBinding(_id, attrib.index, binding));
+        }
+        return;
+    }
+
+    bind();
+    // the attribute pointers capture the Buffer bound to GL_ARRAY_BUFFER at the time of the call
+    StateCache::current().bindBuffer(BufferType::Array, buffer._id);
+    for (const VertexAttribute& attrib : attribs) {
+        const void* pointer = reinterpret_cast<const void*>(static_cast<intptr_t>(offset + attrib.offset));
+        GL_CALL(glEnableVertexAttribArray(attrib.index));
+        if (attrib.interp == VertexAttribInterp::Integer)
+            GL_CALL(glVertexAttribIPointer(attrib.index, attrib.numComponents, toGLenum(attrib.type), stride, pointer));
+        else
+            GL_CALL(glVertexAttribPointer(attrib.index, attrib.numComponents, toGLenum(attrib.type), attrib.normalized, stride, pointer));
+    }
+}
+
+// --------------------------------------------------
+// constructors / destructors
+// --------------------------------------------------
+
+VertexArrayObject::VertexArrayObject() {
+    if (capabilities().directStateAccess)
+        GL_CALL(glCreateVertexArrays(1, &_id));
+    else
+        GL_CALL(glGenVertexArrays(1, &_id));
+    _check();
+}
+VertexArrayObject::VertexArrayObject(VertexArrayObject&& other) : _id(other._id), _deletionQueue(other._deletionQueue), _strides(std::move(other._strides)) {
+    other._id = 0;
+}
+VertexArrayObject::~VertexArrayObject() noexcept {
+    _delete();
+}
+
+// --------------------------------------------------
+// public methods
+// --------------------------------------------------
+
+void VertexArrayObject::bind() const {
+    DEBUG_ONLY(
+    if (_id != 0 && &deletionQueue() != _deletionQueue)
+        throw std::logic_error("VertexArrayObject is bound in a context it was not created in!");
+    );
+    StateCache::current().bindVertexArray(_id);
+}
+
+void VertexArrayObject::setVertexBuffer(const Buffer& buffer, const std::vector<VertexAttribute>& attribs, int stride, int64_t offset, unsigned int binding) {
+    if (offset < 0)
+        throw std::invalid_argument("offset may not be negative!");
+    validateVertexAttributes(attribs, stride);
+    _setVertexBuffer(buffer, attribs, stride, offset, binding);
+}
+
+void VertexArrayObject::setElementBuffer(const Buffer& buffer) {
+    if (capabilities().directStateAccess) {
+        GL_CALL(glVertexArrayElementBuffer(_id, buffer._id));
+        return;
+    }
+    bind();
+    StateCache::current().bindBuffer(BufferType::ElementArray, buffer._id);
+}
+
+void VertexArrayObject::setLayout(const VertexLayout& layout) {
+    if (!capabilities().vertexAttribBinding)
+        throw std::runtime_error("VertexLayout requires ARB_vertex_attrib_binding!");
+
+    bool dsa = capabilities().directStateAccess;
+    if (!dsa)
+        bind();
+    for (const VertexLayout::_Attribute& entry : layout._attributes) {
+        const VertexAttribute& attrib = entry.attribute;
+        if (dsa) {
+            GL_CALL(glEnableVertexArrayAttrib(_id, attrib.index));
+            if (attrib.interp == VertexAttribInterp::Integer)
+                GL_CALL(glVertexArrayAttribIFormat(_id, attrib.index, attrib.numComponents, toGLenum(attrib.type), attrib.offset));
+            else
+                GL_CALL(glVertexArrayAttribFormat(_id, attrib.index, attrib.numComponents, toGLenum(attrib.type), attrib.normalized, attrib.offset));
+            GL_CALL(glVertexArrayAttribBinding(_id, attrib.index, entry.binding));
+        } else {
+            GL_CALL(glEnableVertexAttribArray(attrib.index));
+            if (attrib.interp == VertexAttribInterp::Integer)
+                GL_CALL(glVertexAttribIFormat(attrib.index, attrib.numComponents, toGLenum(attrib.type), attrib.offset));
+            else
+                GL_CALL(glVertexAttribFormat(attrib.index, attrib.numComponents, toGLenum(attrib.type), attrib.normalized, attrib.offset));
+            GL_CALL(glVertexAttribBinding(attrib.index, entry.binding));
+        }
+    }
+    _strides = layout._strides;
+}
+
+void VertexArrayObject::bindVertexBuffer(unsigned int binding, const Buffer& buffer, int64_t offset) {
+    int stride = _stride(binding);
+    if (offset < 0)
+        throw std::invalid_argument("offset may not be negative!");
+    if (capabilities().directStateAccess) {
+        GL_CALL(glVertexArrayVertexBuffer(_id, binding, buffer._id, offset, stride));
+    } else {
+        bind();
+        GL_CALL(glBindVertexBuffer(binding, buffer._id, offset, stride));
+    }
+}
+
+void VertexArrayObject::bindVertexBuffers(unsigned int first, std::span<const BufferSlice> slices) {
+    if (slices.empty())
+        return;
+    for (size_t i = 0; i < slices.size(); i++) {
+        _stride(first + static_cast<unsigned int>(i));
+        if (!slices[i].valid())
+            throw std::logic_error("BufferSlice does not refer to a Buffer!");
+        if (slices[i].offset < 0)
+            throw std::invalid_argument("offset may not be negative!");
+    }
+
+    if (!capabilities().multiBind) {
+        for (size_t i = 0; i < slices.size(); i++)
+            bindVertexBuffer(first + static_cast<unsigned int>(i), *slices[i].buffer, slices[i].offset);
+        return;
+    }
+
+    std::vector<GLuint> ids(slices.size());
+    std::vector<GLintptr> offsets(slices.size());
+    std::vector<GLsizei> strides(slices.size());
+    for (size_t i = 0; i < slices.size(); i++) {
+        ids[i] = slices[i].buffer->_id;
+        offsets[i] = slices[i].offset;
+        strides[i] = _strides[first + i];
+    }
+    GLsizei count = static_cast<GLsizei>(slices.size());
+    if (capabilities().directStateAccess) {
+        GL_CALL(glVertexArrayVertexBuffers(_id, first, count, ids.data(), offsets.data(), strides.data()));
+    } else {
+        bind();
+        GL_CALL(glBindVertexBuffers(first, count, ids.data(), offsets.data(), strides.data()));
+    }
+}
+
+// --------------------------------------------------
+// operator overloads
+// --------------------------------------------------
+
+VertexArrayObject& VertexArrayObject::operator=(VertexArrayObject&& other) {
+    if (this != &other) {
+        _delete();
+        _id = other._id;
+        _deletionQueue = other._deletionQueue;
+        _strides = std::move(other._strides);
+        other._id = 0;
+    }
+    return *this;
+}
+
+}
@@ -0,0 +1,253 @@
+#include <GLA/vertexEncoding.h>
+
+#include <glm/geometric.hpp>
+#include <glm/gtc/packing.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__AVX2__) || defined(__SSE4_1__) || defined(__F16C__)
+    #include <immintrin.h>
+#endif
+
+namespace gla {
+
+namespace {
+    template <typename Src, typename Dst>
+    void checkSizes(std::span<Src> src, std::span<Dst> dst) {
+        if (src.size() != dst.size())
+            throw std::invalid_argument("dst must have as many elements as src!");
+    }
+
+    // accumulates the per component error of one stream
+    struct ErrorAccumulator {
+        EncodeReport report;
+        double sum = 0.0;
+        size_t components = 0;
+
+        void add(float expected, float actual) {
+            float error = std::abs(expected - actual);
+            report.maxError = std::max(report.maxError, error);
+            sum += error;
+            components++;
+        }
+
+        EncodeReport finish(size_t count) {
+            report.count = count;
+            report.meanError = components > 0 ? sum / static_cast<double>(components) : 0.0;
+            return report;
+        }
+    };
+
+    inline float sign(float value) {
+        return value >= 0.0f ? 1.0f : -1.0f;
+    }
+
+    // the SIMD paths must round like the glm fallback, half away from zero, while the native conversions round half to even
+#if defined(__SSE4_1__) || defined(__AVX2__)
+    inline __m128i roundToInt(__m128 value) {
+        const __m128 signBit = _mm_set1_ps(-0.0f);
+        __m128 truncated = _mm_round_ps(value, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+        __m128 away = _mm_cmpge_ps(_mm_andnot_ps(signBit, _mm_sub_ps(value, truncated)), _mm_set1_ps(0.5f));
+        __m128 step = _mm_and_ps(away, _mm_or_ps(_mm_and_ps(value, signBit), _mm_set1_ps(1.0f)));
+        return _mm_cvttps_epi32(_mm_add_ps(truncated, step));
+    }
+#endif
+
+#if defined(__AVX2__)
+    inline __m256i roundToInt(__m256 value) {
+        const __m256 signBit = _mm256_set1_ps(-0.0f);
+        __m256 truncated = _mm256_round_ps(value, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+        __m256 away = _mm256_cmp_ps(_mm256_andnot_ps(signBit, _mm256_sub_ps(value, truncated)), _mm256_set1_ps(0.5f), _CMP_GE_OQ);
+        __m256 step = _mm256_and_ps(away, _mm256_or_ps(_mm256_and_ps(value, signBit), _mm256_set1_ps(1.0f)));
+        return _mm256_cvttps_epi32(_mm256_add_ps(truncated, step));
+    }
+#endif
+
+#if defined(__F16C__)
+    // truncates and steps one half ulp away from zero if the rest is at least half of it, like glm::packHalf1x16
+    inline __m128i toHalf(__m256 value) {
+        const __m256 signBit = _mm256_set1_ps(-0.0f);
+        __m128i half = _mm256_cvtps_ph(value, _MM_FROUND_TO_ZERO);
+        __m256 truncated = _mm256_cvtph_ps(half);
+        __m256 next = _mm256_cvtph_ps(_mm_add_epi16(half, _mm_set1_epi16(1)));
+        // the ulp of the largest finite half is 32, the next value would be infinity
+        __m256 ulp = _mm256_min_ps(_mm256_andnot_ps(signBit, _mm256_sub_ps(next, truncated)), _mm256_set1_ps(32.0f));
+        __m256 rest = _mm256_andnot_ps(signBit, _mm256_sub_ps(value, truncated));
+        __m256i up = _mm256_castps_si256(_mm256_cmp_ps(rest, _mm256_mul_ps(ulp, _mm256_set1_ps(0.5f)), _CMP_GE_OQ)); // NaN and infinity never step
+        return _mm_sub_epi16(half, _mm_packs_epi32(_mm256_castsi256_si128(up), _mm256_extractf128_si256(up, 1)));
+    }
+#endif
+}
+
+EncodeReport encodeHalf(std::span<const float> src, std::span<Half> dst) {
+    checkSizes(src, dst);
+    size_t i = 0;
+#if defined(__F16C__)
+    for (; i + 8 <= src.size(); i += 8) {
+        __m128i half = toHalf(_mm256_loadu_ps(src.data() + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst.data() + i), half);
+    }
+#endif
+    for (; i < src.size(); i++)
+        dst[i].bits = glm::packHalf1x16(src[i]);
+
+    ErrorAccumulator errors;
+    for (size_t j = 0; j < src.size(); j++)
+        errors.add(src[j], glm::unpackHalf1x16(dst[j].bits));
+    return errors.finish(src.size());
+}
+
+EncodeReport encodeSnorm16(std::span<const float> src, std::span<int16_t> dst) {
+    checkSizes(src, dst);
+    size_t i = 0;
+#if defined(__AVX2__)
+    const __m256 low = _mm256_set1_ps(-1.0f), high = _mm256_set1_ps(1.0f), scale = _mm256_set1_ps(32767.0f);
+    for (; i + 8 <= src.size(); i += 8) {
+        __m256 value = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(src.data() + i), low), high);
+        __m256i integer = roundToInt(_mm256_mul_ps(value, scale));
+        __m128i packed = _mm_packs_epi32(_mm256_castsi256_si128(integer), _mm256_extracti128_si256(integer, 1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst.data() + i), packed);
+    }
+#elif defined(__SSE4_1__)
+    const __m128 low = _mm_set1_ps(-1.0f), high = _mm_set1_ps(1.0f), scale = _mm_set1_ps(32767.0f);
+    for (; i + 8 <= src.size(); i += 8) {
+        __m128 a = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(src.data() + i), low), high);
+        __m128 b = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(src.data() + i + 4), low), high);
+        __m128i packed = _mm_packs_epi32(roundToInt(_mm_mul_ps(a, scale)), roundToInt(_mm_mul_ps(b, scale)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst.data() + i), packed);
+    }
+#endif
+    for (; i < src.size(); i++)
+        dst[i] = static_cast<int16_t>(glm::packSnorm1x16(src[i]));
+
+    ErrorAccumulator errors;
+    for (size_t j = 0; j < src.size(); j++)
+        errors.add(std::clamp(src[j], -1.0f, 1.0f), std::max(dst[j] / 32767.0f, -1.0f));
+    return errors.finish(src.size());
+}
+
+EncodeReport encodeUnorm16(std::span<const float> src, std::span<uint16_t> dst) {
+    checkSizes(src, dst);
+    size_t i = 0;
+#if defined(__AVX2__)
+    const __m256 low = _mm256_setzero_ps(), high = _mm256_set1_ps(1.0f), scale = _mm256_set1_ps(65535.0f);
+    for (; i + 8 <= src.size(); i += 8) {
+        __m256 value = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(src.data() + i), low), high);
+        __m256i integer = roundToInt(_mm256_mul_ps(value, scale));
+        __m128i packed = _mm_packus_epi32(_mm256_castsi256_si128(integer), _mm256_extracti128_si256(integer, 1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst.data() + i), packed);
+    }
+#elif defined(__SSE4_1__)
+    const __m128 low = _mm_setzero_ps(), high = _mm_set1_ps(1.0f), scale = _mm_set1_ps(65535.0f);
+    for (; i + 8 <= src.size(); i += 8) {
+        __m128 a = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(src.data() + i), low), high);
+        __m128 b = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(src.data() + i + 4), low), high);
+        __m128i packed = _mm_packus_epi32(roundToInt(_mm_mul_ps(a, scale)), roundToInt(_mm_mul_ps(b, scale)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst.data() + i), packed);
+    }
+#endif
+    for (; i < src.size(); i++)
+        dst[i] = glm::packUnorm1x16(src[i]);
+
+    ErrorAccumulator errors;
+    for (size_t j = 0; j < src.size(); j++)
+        errors.add(std::clamp(src[j], 0.0f, 1.0f), dst[j] / 65535.0f);
+    return errors.finish(src.size());
+}
+
+EncodeReport encodeOctahedral(std::span<const glm::vec3> src, std::span<glm::i16vec2> dst) {
+    checkSizes(src, dst);
+    ErrorAccumulator errors;
+    for (size_t i = 0; i < src.size(); i++) {
+        glm::vec3 n = src[i];
+        float length = std::abs(n.x) + std::abs(n.y) + std::abs(n.z);
+        n = length > 0.0f ? n / length : glm::vec3(0.0f, 0.0f, 1.0f);
+        glm::vec2 e(n.x, n.y);
+        if (n.z < 0.0f)
+            e = glm::vec2((1.0f - std::abs(n.y)) * sign(n.x), (1.0f - std::abs(n.x)) * sign(n.y));
+        dst[i] = glm::i16vec2(static_cast<int16_t>(glm::packSnorm1x16(e.x)), static_cast<int16_t>(glm::packSnorm1x16(e.y)));
+
+        glm::vec2 d(std::max(dst[i].x / 32767.0f, -1.0f), std::max(dst[i].y / 32767.0f, -1.0f));
+        glm::vec3 decoded(d, 1.0f - std::abs(d.x) - std::abs(d.y));
+        float t = std::max(-decoded.z, 0.0f);
+        decoded.x -= sign(decoded.x) * t;
+        decoded.y -= sign(decoded.y) * t;
+        decoded = glm::normalize(decoded);
+        glm::vec3 expected = length > 0.0f ? glm::normalize(src[i]) : glm::vec3(0.0f, 0.0f, 1.0f);
+        for (int c = 0; c < 3; c++)
+            errors.add(expected[c], decoded[c]);
+    }
+    return errors.finish(src.size());
+}
+
+EncodeReport encodeSnorm2101010(std::span<const glm::vec4> src, std::span<PackedSnorm2101010> dst) {
+    checkSizes(src, dst);
+    size_t i = 0;
+#if defined(__SSE4_1__) || defined(__AVX2__)
+    const __m128 low = _mm_set1_ps(-1.0f), high = _mm_set1_ps(1.0f), scale = _mm_setr_ps(511.0f, 511.0f, 511.0f, 1.0f);
+    const __m128i mask = _mm_setr_epi32(0x3FF, 0x3FF, 0x3FF, 0x3), shift = _mm_setr_epi32(1, 1 << 10, 1 << 20, 1 << 30);
+    for (; i < src.size(); i++) {
+        __m128 value = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(&src[i].x), low), high);
+        __m128i bits = _mm_mullo_epi32(_mm_and_si128(roundToInt(_mm_mul_ps(value, scale)), mask), shift);
+        // the fields don't overlap, so or-ing the lanes together packs them
+        bits = _mm_or_si128(bits, _mm_shuffle_epi32(bits, _MM_SHUFFLE(1, 0, 3, 2)));
+        bits = _mm_or_si128(bits, _mm_shuffle_epi32(bits, _MM_SHUFFLE(2, 3, 0, 1)));
+        dst[i].bits = static_cast<uint32_t>(_mm_cvtsi128_si32(bits));
+    }
+#endif
+    for (; i < src.size(); i++)
+        dst[i].bits = glm::packSnorm3x10_1x2(src[i]);
+
+    ErrorAccumulator errors;
+    for (size_t j = 0; j < src.size(); j++) {
+        glm::vec4 decoded = glm::unpackSnorm3x10_1x2(dst[j].bits);
+        glm::vec4 expected = glm::clamp(src[j], -1.0f, 1.0f);
+        expected.w = std::round(expected.w);
+        for (int c = 0; c < 4; c++)
+            errors.add(expected[c], decoded[c]);
+    }
+    return errors.finish(src.size());
+}
+
+EncodeReport encodeUnorm2101010(std::span<const glm::vec4> src, std::span<PackedUnorm2101010> dst) {
+    checkSizes(src, dst);
+    size_t i = 0;
+#if defined(__SSE4_1__) || defined(__AVX2__)
+    const __m128 low = _mm_setzero_ps(), high = _mm_set1_ps(1.0f), scale = _mm_setr_ps(1023.0f, 1023.0f, 1023.0f, 3.0f);
+    const __m128i shift = _mm_setr_epi32(1, 1 << 10, 1 << 20, 1 << 30);
+    for (; i < src.size(); i++) {
+        __m128 value = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(&src[i].x), low), high);
+        __m128i bits = _mm_mullo_epi32(roundToInt(_mm_mul_ps(value, scale)), shift);
+        bits = _mm_or_si128(bits, _mm_shuffle_epi32(bits, _MM_SHUFFLE(1, 0, 3, 2)));
+        bits = _mm_or_si128(bits, _mm_shuffle_epi32(bits, _MM_SHUFFLE(2, 3, 0, 1)));
+        dst[i].bits = static_cast<uint32_t>(_mm_cvtsi128_si32(bits));
+    }
+#endif
+    for (; i < src.size(); i++)
+        dst[i].bits = glm::packUnorm3x10_1x2(src[i]);
+
+    ErrorAccumulator errors;
+    for (size_t j = 0; j < src.size(); j++) {
+        glm::vec4 decoded = glm::unpackUnorm3x10_1x2(dst[j].bits);
+        glm::vec4 expected = glm::clamp(src[j], 0.0f, 1.0f);
+        for (int c = 0; c < 4; c++)
+            errors.add(expected[c], decoded[c]);
+    }
+    return errors.finish(src.size());
+}
+
+EncodeReport encodeUfloat111110(std::span<const glm::vec3> src, std::span<PackedUfloat111110> dst) {
+    checkSizes(src, dst);
+    ErrorAccumulator errors;
+    for (size_t i = 0; i < src.size(); i++) {
+        glm::vec3 value = glm::max(src[i], glm::vec3(0.0f));
+        dst[i].bits = glm::packF2x11_1x10(value);
+        glm::vec3 decoded = glm::unpackF2x11_1x10(dst[i].bits);
+        for (int c = 0; c < 3; c++)
+            errors.add(value[c], decoded[c]);
+    }
+    return errors.finish(src.size());
+}
+
+}
@@ -0,0 +1,287 @@
+#include <GLA/vertexInterleave.h>
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64)
+    #include <emmintrin.h>
+    #define GLA_SSE2
+#endif
+#ifdef __AVX__
+    #include <immintrin.h>
+#endif
+
+namespace gla {
+
+namespace {
+    constexpr size_t BLOCK_BYTES = 16 * 1024;           // vertices assembled per block, fits into L1 together with the sources
+    constexpr size_t STREAM_THRESHOLD = 256 * 1024;     // smaller outputs are likely read again soon, keep them in the cache
+
+    void checkLayout(std::span<const VertexAttribute> attribs, int stride, size_t streams) {
+        if (stride <= 0)
+            throw std::invalid_argument("stride must be greater than 0!");
+        if (streams != attribs.size())
+            throw std::invalid_argument("There must be exactly one stream per VertexAttribute!");
+        for (const VertexAttribute& attrib : attribs)
+            if (attrib.offset < 0 || attrib.offset + attributeBytes(attrib.type, attrib.numComponents) > stride)
+                throw std::invalid_argument("Given VertexAttributes are bigger than the stride!");
+    }
+
+    // fixed size copies compile to single moves instead of memcpy calls
+    template <size_t N>
+    void gather(const char* src, char* dst, size_t dstStride, size_t count) {
+        for (size_t i = 0; i < count; i++)
+            std::memcpy(dst + i * dstStride, src + i * N, N);
+    }
+
+    template <size_t N>
+    void scatter(const char* src, size_t srcStride, char* dst, size_t count) {
+        for (size_t i = 0; i < count; i++)
+            std::memcpy(dst + i * N, src + i * srcStride, N);
+    }
+
+#ifdef GLA_SSE2
+    // 16 byte elements (vec4): with AVX two elements move per 32 byte load or store on the packed side
+    void gather16(const char* src, char* dst, size_t dstStride, size_t count) {
+        size_t i = 0;
+#ifdef __AVX__
+        for (; i + 4 <= count; i += 4) {
+            __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 16));
+            __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 16 + 32));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * dstStride), _mm256_castsi256_si128(a));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + (i + 1) * dstStride), _mm256_extractf128_si256(a, 1));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + (i + 2) * dstStride), _mm256_castsi256_si128(b));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + (i + 3) * dstStride), _mm256_extractf128_si256(b, 1));
+        }
+#else
+        for (; i + 4 <= count; i += 4) {
+            for (size_t j = 0; j < 4; j++)
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + (i + j) * dstStride), _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + (i + j) * 16)));
+        }
+#endif
+        gather<16>(src + i * 16, dst + i * dstStride, dstStride, count - i);
+    }
+
+    void scatter16(const char* src, size_t srcStride, char* dst, size_t count) {
+        size_t i = 0;
+#ifdef __AVX__
+        for (; i + 4 <= count; i += 4) {
+            __m256i a = _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * srcStride)));
+            __m256i b = _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + (i + 2) * srcStride)));
+            a = _mm256_insertf128_si256(a, _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + (i + 1) * srcStride)), 1);
+            b = _mm256_insertf128_si256(b, _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + (i + 3) * srcStride)), 1);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 16), a);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 16 + 32), b);
+        }
+#else
+        for (; i + 4 <= count; i += 4) {
+            for (size_t j = 0; j < 4; j++)
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + (i + j) * 16), _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + (i + j) * srcStride)));
+        }
+#endif
+        scatter<16>(src + i * srcStride, srcStride, dst + i * 16, count - i);
+    }
+
+    // 12 byte elements (vec3): four elements are 48 bytes, so three loads or stores on the packed side instead of eight
+    inline void store12(char* dst, __m128i value) {
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), value);
+        int last = _mm_cvtsi128_si32(_mm_srli_si128(value, 8));
+        std::memcpy(dst + 8, &last, 4);
+    }
+
+    void gather12(const char* src, char* dst, size_t dstStride, size_t count) {
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 12));      // x0 y0 z0 x1
+            __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 12 + 16)); // y1 z1 x2 y2
+            __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 12 + 32)); // z2 x3 y3 z3
+            store12(dst + i * dstStride, a);
+            store12(dst + (i + 1) * dstStride, _mm_or_si128(_mm_srli_si128(a, 12), _mm_slli_si128(b, 4)));
+            store12(dst + (i + 2) * dstStride, _mm_or_si128(_mm_srli_si128(b, 8), _mm_slli_si128(c, 8)));
+            store12(dst + (i + 3) * dstStride, _mm_srli_si128(c, 4));
+        }
+        gather<12>(src + i * 12, dst + i * dstStride, dstStride, count - i);
+    }
+
+    // the elements are read with 16 byte loads, which stay inside the source as long as another vertex follows
+    void scatter12(const char* src, size_t srcStride, char* dst, size_t count) {
+        const __m128i mask = _mm_setr_epi32(-1, -1, -1, 0);
+        size_t i = 0;
+        for (; i + 5 <= count; i += 4) {
+            __m128i a = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * srcStride)), mask);
+            __m128i b = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + (i + 1) * srcStride)), mask);
+            __m128i c = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + (i + 2) * srcStride)), mask);
+            __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + (i + 3) * srcStride));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 12), _mm_or_si128(a, _mm_slli_si128(b, 12)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 12 + 16), _mm_or_si128(_mm_srli_si128(b, 4), _mm_slli_si128(c, 8)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 12 + 32), _mm_or_si128(_mm_srli_si128(c, 8), _mm_slli_si128(d, 4)));
+        }
+        scatter<12>(src + i * srcStride, srcStride, dst + i * 12, count - i);
+    }
+#endif
+
+    void gather(size_t size, const char* src, char* dst, size_t dstStride, size_t count) {
+#ifdef GLA_SSE2
+        if (size == 12)
+            return gather12(src, dst, dstStride, count);
+        if (size == 16)
+            return gather16(src, dst, dstStride, count);
+#endif
+        switch (size) {
+        case 1:  gather<1>(src, dst, dstStride, count); return;
+        case 2:  gather<2>(src, dst, dstStride, count); return;
+        case 4:  gather<4>(src, dst, dstStride, count); return;
+        case 6:  gather<6>(src, dst, dstStride, count); return;
+        case 8:  gather<8>(src, dst, dstStride, count); return;
+        case 12: gather<12>(src, dst, dstStride, count); return;
+        case 16: gather<16>(src, dst, dstStride, count); return;
+        case 24: gather<24>(src, dst, dstStride, count); return;
+        case 32: gather<32>(src, dst, dstStride, count); return;
+        }
+        for (size_t i = 0; i < count; i++)
+            std::memcpy(dst + i * dstStride, src + i * size, size);
+    }
+
+    void scatter(size_t size, const char* src, size_t srcStride, char* dst, size_t count) {
+#ifdef GLA_SSE2
+        if (size == 12)
+            return scatter12(src, srcStride, dst, count);
+        if (size == 16)
+            return scatter16(src, srcStride, dst, count);
+#endif
+        switch (size) {
+        case 1:  scatter<1>(src, srcStride, dst, count); return;
+        case 2:  scatter<2>(src, srcStride, dst, count); return;
+        case 4:  scatter<4>(src, srcStride, dst, count); return;
+        case 6:  scatter<6>(src, srcStride, dst, count); return;
+        case 8:  scatter<8>(src, srcStride, dst, count); return;
+        case 12: scatter<12>(src, srcStride, dst, count); return;
+        case 16: scatter<16>(src, srcStride, dst, count); return;
+        case 24: scatter<24>(src, srcStride, dst, count); return;
+        case 32: scatter<32>(src, srcStride, dst, count); return;
+        }
+        for (size_t i = 0; i < count; i++)
+            std::memcpy(dst + i * size, src + i * srcStride, size);
+    }
+
+    // copies a finished block to the destination, bypassing the cache if requested
+    void flush(char* dst, const char* src, size_t size, bool streaming) {
+#ifdef GLA_SSE2
+        if (streaming) {
+            size_t head = std::min(size, (16 - reinterpret_cast<uintptr_t>(dst) % 16) % 16);
+            std::memcpy(dst, src, head);
+            size_t i = head;
+            for (; i + 64 <= size; i += 64) {
+                __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+                __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 16));
+                __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 32));
+                __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 48));
+                _mm_stream_si128(reinterpret_cast<__m128i*>(dst + i), a);
+                _mm_stream_si128(reinterpret_cast<__m128i*>(dst + i + 16), b);
+                _mm_stream_si128(reinterpret_cast<__m128i*>(dst + i + 32), c);
+                _mm_stream_si128(reinterpret_cast<__m128i*>(dst + i + 48), d);
+            }
+            for (; i + 16 <= size; i += 16)
+                _mm_stream_si128(reinterpret_cast<__m128i*>(dst + i), _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)));
+            std::memcpy(dst + i, src + i, size - i);
+            return;
+        }
+#endif
+        std::memcpy(dst, src, size);
+    }
+}
+
+void interleaveVertices(std::span<const VertexAttribute> attribs, int stride, std::span<const void* const> streams, size_t count, void* dst) {
+    checkLayout(attribs, stride, streams.size());
+    if (count == 0)
+        return;
+
+    alignas(64) char block[BLOCK_BYTES];
+    size_t vertexSize = static_cast<size_t>(stride);
+    size_t blockVertices = std::max<size_t>(1, BLOCK_BYTES / vertexSize);
+    bool streaming = count * vertexSize >= STREAM_THRESHOLD;
+    char* out = static_cast<char*>(dst);
+
+    if (blockVertices * vertexSize > BLOCK_BYTES) {
+        // a single vertex doesn't fit into the block, write in place
+        std::memset(out, 0, count * vertexSize);
+        for (size_t a = 0; a < attribs.size(); a++) {
+            size_t size = attributeBytes(attribs[a].type, attribs[a].numComponents);
+            gather(size, static_cast<const char*>(streams[a]), out + attribs[a].offset, vertexSize, count);
+        }
+        return;
+    }
+
+    std::memset(block, 0, blockVertices * vertexSize); // padding between attributes stays zero
+    for (size_t first = 0; first < count; first += blockVertices) {
+        size_t n = std::min(blockVertices, count - first);
+        for (size_t a = 0; a < attribs.size(); a++) {
+            size_t size = attributeBytes(attribs[a].type, attribs[a].numComponents);
+            gather(size, static_cast<const char*>(streams[a]) + first * size, block + attribs[a].offset, vertexSize, n);
+        }
+        flush(out + first * vertexSize, block, n * vertexSize, streaming);
+    }
+#ifdef GLA_SSE2
+    if (streaming)
+        _mm_sfence();
+#endif
+}
+
+void deinterleaveVertices(std::span<const VertexAttribute> attribs, int stride, const void* src, size_t count, std::span<void* const> streams) {
+    checkLayout(attribs, stride, streams.size());
+    if (count == 0)
+        return;
+
+    alignas(64) char block[BLOCK_BYTES];
+    size_t vertexSize = static_cast<size_t>(stride);
+    size_t blockVertices = std::max<size_t>(1, BLOCK_BYTES / vertexSize);
+    const char* in = static_cast<const char*>(src);
+
+    if (blockVertices * vertexSize > BLOCK_BYTES) {
+        for (size_t a = 0; a < attribs.size(); a++) {
+            size_t size = attributeBytes(attribs[a].type, attribs[a].numComponents);
+            scatter(size, in + attribs[a].offset, vertexSize, static_cast<char*>(streams[a]), count);
+        }
+        return;
+    }
+
+    for (size_t first = 0; first < count; first += blockVertices) {
+        size_t n = std::min(blockVertices, count - first);
+        // one sequential read of the block, the scattered reads then hit the cache
+        std::memcpy(block, in + first * vertexSize, n * vertexSize);
+        for (size_t a = 0; a < attribs.size(); a++) {
+            size_t size = attributeBytes(attribs[a].type, attribs[a].numComponents);
+            scatter(size, block + attribs[a].offset, vertexSize, static_cast<char*>(streams[a]) + first * size, n);
+        }
+    }
+}
+
+void interleaveVertices(Buffer& buffer, int64_t offset, std::span<const VertexAttribute> attribs, int stride, std::span<const void* const> streams, size_t count) {
+    checkLayout(attribs, stride, streams.size());
+    if (count == 0)
+        return;
+    void* dst = buffer.map(offset, static_cast<int64_t>(count) * stride, MapUsage::Write | MapUsage::InvalidRange);
+    try {
+        interleaveVertices(attribs, stride, streams, count, dst);
+    } catch (...) {
+        buffer.unmap();
+        throw;
+    }
+    buffer.unmap();
+}
+
+void deinterleaveVertices(Buffer& buffer, int64_t offset, std::span<const VertexAttribute> attribs, int stride, size_t count, std::span<void* const> streams) {
+    checkLayout(attribs, stride, streams.size());
+    if (count == 0)
+        return;
+    const void* src = buffer.map(offset, static_cast<int64_t>(count) * stride, MapUsage::Read);
+    try {
+        deinterleaveVertices(attribs, stride, src, count, streams);
+    } catch (...) {
+        buffer.unmap();
+        throw;
+    }
+    buffer.unmap();
+}
+
+}
@@ -0,0 +1,57 @@
+#include <GLA/vertexLayout.h>
+
+#include <GLA/capabilities.h>
+
+#include <string>
+
+namespace gla {
+
+// ----------------------------------------------------------------------------------------------------
+// class VertexLayout
+// ----------------------------------------------------------------------------------------------------
+
+// --------------------------------------------------
+// protected methods
+// --------------------------------------------------
+
+void VertexLayout::_addStream(unsigned int binding, std::span<const VertexAttribute> attribs, int stride) {
+    if (binding >= static_cast<unsigned int>(capabilities().maxVertexAttribBindings))
+        throw std::invalid_argument("The current GPU does not support binding indexes over " + std::to_string(capabilities().maxVertexAttribBindings - 1) + "!");
+    if (binding < _strides.size() && _strides[binding] != 0)
+        throw std::invalid_argument("Binding " + std::to_string(binding) + " is already used by another stream!");
+    for (const VertexAttribute& attrib : attribs)
+        for (const _Attribute& other : _attributes)
+            if (other.attribute.index == attrib.index)
+                throw std::invalid_argument("Attribute index " + std::to_string(attrib.index) + " is already used by another stream!");
+
+    if (binding >= _strides.size())
+        _strides.resize(binding + 1, 0);
+    _strides[binding] = stride;
+    for (const VertexAttribute& attrib : attribs)
+        _attributes.push_back({ attrib, binding });
+}
+
+// --------------------------------------------------
+// constructors / destructors
+// --------------------------------------------------
+
+VertexLayout::VertexLayout(const std::vector<VertexAttribute>& attribs, int stride) {
+    addStream(0, attribs, stride);
+}
+
+// --------------------------------------------------
+// public methods
+// --------------------------------------------------
+
+void VertexLayout::addStream(unsigned int binding, const std::vector<VertexAttribute>& attribs, int stride) {
+    validateVertexAttributes(attribs, stride);
+    _addStream(binding, attribs, stride);
+}
+
+int VertexLayout::stride(unsigned int binding) const {
+    if (binding >= _strides.size() || _strides[binding] == 0)
+        throw std::out_of_range("No stream uses binding " + std::to_string(binding) + "!");
+    return _strides[binding];
+}
+
+}
@@ -2,6 +2,9 @@
 #include <GLFW/glfw3.h>
 
 #include <GLA/windowContext.h>
+#include <GLA/capabilities.h>
+#include <GLA/deletionQueue.h>
+#include <GLA/memoryTracker.h>
 
 #include <mutex>
 #include <stdexcept>
@@ -12,6 +15,8 @@ namespace gla {
 namespace {
     int glfwRefCount = 0;
     bool glfwInitialized = false;
+    int liveContexts = 0; // the MemoryTracker counts the objects of all contexts, so only the last one can report leaks
+    const WindowContext* frameContext = nullptr; // the MemoryTracker is process-wide, so only one context ends its frames
 }
 
 void glfwErrorCallback(int error, const char* description) {
@@ -58,6 +63,8 @@ void WindowContext::useContext() {
     if (window == NULL)
         throw std::runtime_error("GLFW Window is invalid!");
     glfwMakeContextCurrent(window);
+    StateCache::makeCurrent(&_stateCache);
+    DeletionQueue::makeCurrent(_deletionQueue.get());
 }
 
 bool WindowContext::shouldClose() {
@@ -70,6 +77,11 @@ void WindowContext::swapBuffers() {
     if (window == NULL)
         throw std::runtime_error("GLFW Window is invalid!");
     glfwSwapBuffers(window);
+    _deletionQueue->endFrame();
+    if (frameContext == nullptr)
+        frameContext = this;
+    if (frameContext == this)
+        memoryTracker().endFrame();
 }
 
 // --------------------------------------------------
@@ -180,6 +192,9 @@ WindowContext::WindowContext(int width, int height, const char* windowName) {
     glewExperimental = GL_TRUE;
     if (glewInit() != GLEW_OK)
         throw std::runtime_error("Could not initialize GLEW!");
+    queryCapabilities();
+    _deletionQueue->setEnabled(true);
+    ++liveContexts;
     
     glfwSetWindowUserPointer(window, this);
 
@@ -202,14 +217,35 @@ WindowContext::WindowContext(int width, int height, const char* windowName) {
     glfwSetWindowRefreshCallback(window, _onWindowRefresh);
 }
 
-WindowContext::WindowContext(WindowContext&& other) : window(other.window), _ownsGLFW(other._ownsGLFW) {
+WindowContext::WindowContext(WindowContext&& other) : window(other.window), _ownsGLFW(other._ownsGLFW), _stateCache(other._stateCache), _deletionQueue(std::move(other._deletionQueue)) {
     other.window = NULL;
     other._ownsGLFW = false;
+    if (StateCache::isCurrent(&other._stateCache))
+        StateCache::makeCurrent(&_stateCache);
+    if (frameContext == &other)
+        frameContext = this;
 
     glfwSetWindowUserPointer(window, this);
 }
 
 WindowContext::~WindowContext() {
+    if (window != NULL) {
+        // objects released by the application are still queued and need the context to be deleted
+        glfwMakeContextCurrent(window);
+        StateCache::makeCurrent(&_stateCache);
+        _deletionQueue->setEnabled(false);
+        if (--liveContexts == 0) {
+            std::string leaks = memoryTracker().leakReport();
+            if (!leaks.empty())
+                std::cerr << leaks;
+        }
+    }
+    if (StateCache::isCurrent(&_stateCache))
+        StateCache::makeCurrent(nullptr);
+    if (_deletionQueue && DeletionQueue::isCurrent(_deletionQueue.get()))
+        DeletionQueue::makeCurrent(nullptr);
+    if (frameContext == this)
+        frameContext = nullptr; // the next context to swap its buffers takes over
     if (window != NULL)
         glfwDestroyWindow(window);
     if (_ownsGLFW)
@@ -223,13 +259,30 @@ WindowContext::~WindowContext() {
 WindowContext& WindowContext::operator=(WindowContext&& other) {
     if (this != &other) {
         if (window != NULL) {
+            glfwMakeContextCurrent(window);
+            StateCache::makeCurrent(&_stateCache);
+            _deletionQueue->drain();
             glfwDestroyWindow(window);
+            --liveContexts;
             if (_ownsGLFW) terminateGLFW();
         }
+        if (frameContext == this)
+            frameContext = nullptr;
+        if (StateCache::isCurrent(&_stateCache))
+            StateCache::makeCurrent(nullptr);
+        if (_deletionQueue && DeletionQueue::isCurrent(_deletionQueue.get()))
+            DeletionQueue::makeCurrent(nullptr);
         window = other.window;
         _ownsGLFW = other._ownsGLFW;
+        _stateCache = other._stateCache;
+        _deletionQueue = std::move(other._deletionQueue);
         other.window = NULL;
         other._ownsGLFW = false;
+        if (StateCache::isCurrent(&other._stateCache))
+            StateCache::makeCurrent(&_stateCache);
+        if (frameContext == &other)
+            frameContext = this;
+        glfwSetWindowUserPointer(window, this);
     }
     return *this;
 }
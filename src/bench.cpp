@@ -0,0 +1,255 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+
+#include <GLA/buffer.h>
+#include <GLA/bufferHeap.h>
+#include <GLA/debug.h>
+#include <GLA/vertexArray.h>
+#include <GLA/vertexArrayObject.h>
+#include <GLA/vertexInterleave.h>
+#include <GLA/windowContext.h>
+
+// Micro benchmarks of the CPU side costs, build without DEBUG_BUILD for meaningful numbers (GL_CALL checks glGetError).
+
+namespace {
+    constexpr int RUNS = 5; // the fastest run is reported, the others absorb warm up and scheduling noise
+
+    // fastest of RUNS calls of f in nanoseconds
+    template <typename F>
+    double measure(F&& f) {
+        double best = std::numeric_limits<double>::max();
+        for (int run = 0; run < RUNS; run++) {
+            auto start = std::chrono::steady_clock::now();
+            f();
+            auto end = std::chrono::steady_clock::now();
+            best = std::min(best, std::chrono::duration<double, std::nano>(end - start).count());
+        }
+        return best;
+    }
+
+    std::vector<gla::VertexAttribute> vec4Attributes(int count) {
+        std::vector<gla::VertexAttribute> attribs;
+        for (int i = 0; i < count; i++)
+            attribs.push_back({ static_cast<unsigned int>(i), 4, gla::VertexAttribType::Float, gla::VertexAttribInterp::Float, false, i * 16 });
+        return attribs;
+    }
+
+    // interleaving and deinterleaving of typical attribute streams (position, normal, uv, ...) against a per vertex memcpy loop
+    void benchInterleave() {
+        constexpr int COMPONENTS[] = { 3, 3, 2, 4, 1, 4 };
+
+        std::printf("interleave / deinterleave, float streams of %d %d %d %d %d %d components\n", COMPONENTS[0], COMPONENTS[1], COMPONENTS[2], COMPONENTS[3], COMPONENTS[4], COMPONENTS[5]);
+        std::printf("%8s %10s %12s %16s %18s\n", "streams", "vertices", "naive GB/s", "interleave GB/s", "deinterleave GB/s");
+
+        for (size_t numStreams = 1; numStreams <= std::size(COMPONENTS); numStreams++) {
+            std::vector<gla::VertexAttribute> attribs;
+            int stride = 0;
+            for (size_t a = 0; a < numStreams; a++) {
+                attribs.push_back({ static_cast<unsigned int>(a), COMPONENTS[a], gla::VertexAttribType::Float, gla::VertexAttribInterp::Float, false, stride });
+                stride += COMPONENTS[a] * 4;
+            }
+
+            for (size_t count : { size_t(1) << 10, size_t(1) << 16, size_t(1) << 20 }) {
+                std::vector<std::vector<char>> sources(numStreams);
+                std::vector<std::vector<char>> targets(numStreams);
+                std::vector<const void*> streams;
+                std::vector<void*> outputs;
+                for (size_t a = 0; a < numStreams; a++) {
+                    sources[a].assign(count * COMPONENTS[a] * 4, static_cast<char>(a + 1));
+                    targets[a].resize(sources[a].size());
+                    streams.push_back(sources[a].data());
+                    outputs.push_back(targets[a].data());
+                }
+                std::vector<char> interleaved(count * stride);
+
+                double naive = measure([&] {
+                    for (size_t i = 0; i < count; i++)
+                        for (size_t a = 0; a < numStreams; a++) {
+                            size_t size = COMPONENTS[a] * 4;
+                            std::memcpy(interleaved.data() + i * stride + attribs[a].offset, sources[a].data() + i * size, size);
+                        }
+                });
+                double interleave = measure([&] { gla::interleaveVertices(attribs, stride, streams, count, interleaved.data()); });
+                double deinterleave = measure([&] { gla::deinterleaveVertices(attribs, stride, interleaved.data(), count, outputs); });
+
+                double bytes = static_cast<double>(count) * stride;
+                std::printf("%8zu %10zu %12.2f %16.2f %18.2f\n", numStreams, count, bytes / naive, bytes / interleave, bytes / deinterleave);
+            }
+        }
+        std::printf("\n");
+    }
+}
+
+class BenchWindow : public gla::WindowContext {
+public:
+    BenchWindow() : gla::WindowContext(64, 64, "Bench") {}
+
+    // per draw setup: respecifying the attributes with VertexArray::setAttributes against binding a recorded VertexArrayObject
+    void benchVertexSetup() {
+        constexpr int MESHES = 64;
+        constexpr int FRAMES = 200;
+
+        std::printf("per draw vertex setup, %d meshes x %d frames\n", MESHES, FRAMES);
+        std::printf("%8s %18s %18s %8s\n", "attribs", "setAttributes ns", "VAO::bind ns", "speedup");
+
+        GL_CALL(glEnable(GL_RASTERIZER_DISCARD)); // only the vertex setup and draw submission are measured
+        for (int numAttribs : { 1, 2, 4, 8, 16 }) {
+            std::vector<gla::VertexAttribute> attribs = vec4Attributes(numAttribs);
+            int stride = numAttribs * 16;
+
+            std::vector<gla::VertexArray> arrays;
+            std::vector<gla::VertexArrayObject> vaos;
+            arrays.reserve(MESHES);
+            vaos.reserve(MESHES);
+            std::vector<float> vertices(3 * numAttribs * 4, 0.0f);
+            for (int i = 0; i < MESHES; i++) {
+                arrays.emplace_back();
+                arrays.back().setData(vertices, gla::BufferUsage::StaticDraw);
+            }
+            for (int i = 0; i < MESHES; i++) {
+                vaos.emplace_back();
+                vaos.back().setVertexBuffer(arrays[i], attribs, stride);
+            }
+
+            double attributes = measure([&] {
+                for (int frame = 0; frame < FRAMES; frame++) {
+                    for (gla::VertexArray& array : arrays) {
+                        array.setAttributes(attribs, stride);
+                        GL_CALL(glDrawArrays(GL_TRIANGLES, 0, 3));
+                    }
+                }
+                GL_CALL(glFinish());
+            });
+            double bind = measure([&] {
+                for (int frame = 0; frame < FRAMES; frame++) {
+                    for (const gla::VertexArrayObject& vao : vaos) {
+                        vao.bind();
+                        GL_CALL(glDrawArrays(GL_TRIANGLES, 0, 3));
+                    }
+                }
+                GL_CALL(glFinish());
+            });
+
+            double draws = static_cast<double>(MESHES) * FRAMES;
+            std::printf("%8d %18.1f %18.1f %7.2fx\n", numAttribs, attributes / draws, bind / draws, attributes / bind);
+        }
+        GL_CALL(glDisable(GL_RASTERIZER_DISCARD));
+        std::printf("\n");
+    }
+
+    // setSubData of the whole Buffer followed by a draw reading it, with every UpdatePolicy
+    void benchUpdatePolicy() {
+        constexpr int UPDATES = 64;
+        constexpr gla::UpdatePolicy POLICIES[] = { gla::UpdatePolicy::SubData, gla::UpdatePolicy::Orphan, gla::UpdatePolicy::Invalidate, gla::UpdatePolicy::MapInvalidate };
+
+        std::printf("setSubData per UpdatePolicy, %d updates each followed by a draw\n", UPDATES);
+        std::printf("%10s %14s %14s %14s %16s\n", "bytes", "SubData us", "Orphan us", "Invalidate us", "MapInvalidate us");
+
+        GL_CALL(glEnable(GL_RASTERIZER_DISCARD));
+        for (int64_t size : { int64_t(256), int64_t(4) << 10, int64_t(64) << 10, int64_t(1) << 20, int64_t(4) << 20 }) {
+            std::vector<char> data(size, 1);
+            gla::Buffer buffer(gla::BufferType::Array);
+            buffer.setData(size, data.data(), gla::BufferUsage::DynamicDraw);
+            gla::VertexArrayObject vao;
+            vao.setVertexBuffer(buffer, vec4Attributes(1), 16);
+            vao.bind();
+
+            double times[std::size(POLICIES)];
+            for (size_t p = 0; p < std::size(POLICIES); p++) {
+                buffer.setUpdatePolicy(POLICIES[p]);
+                times[p] = measure([&] {
+                    for (int i = 0; i < UPDATES; i++) {
+                        buffer.setSubData(0, size, data.data());
+                        GL_CALL(glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(size / 16)));
+                    }
+                    GL_CALL(glFinish());
+                }) / UPDATES / 1000.0;
+            }
+            std::printf("%10lld %14.2f %14.2f %14.2f %16.2f\n", static_cast<long long>(size), times[0], times[1], times[2], times[3]);
+        }
+        GL_CALL(glDisable(GL_RASTERIZER_DISCARD));
+        std::printf("\n");
+    }
+
+    // allocating, uploading to and freeing N BufferSlices of a BufferHeap against N standalone Buffers
+    void benchBufferHeap() {
+        constexpr int64_t BLOCK_SIZE = 4 << 20;
+
+        std::printf("BufferHeap against standalone Buffers, slices of 256 B to 16 KB\n");
+        std::printf("%8s %14s %16s %8s\n", "objects", "Buffer us", "BufferHeap us", "speedup");
+
+        std::vector<char> data(16 << 10, 1);
+        auto sizeOf = [](int i) { return int64_t(256) + (static_cast<int64_t>(i) * 7919) % ((16 << 10) - 256); };
+        for (int count : { 64, 1024, 8192 }) {
+            double standalone = measure([&] {
+                std::vector<gla::Buffer> buffers;
+                buffers.reserve(count);
+                for (int i = 0; i < count; i++) {
+                    buffers.emplace_back(gla::BufferType::Array);
+                    buffers.back().setStorage(sizeOf(i), data.data(), gla::BufferFlag::DynamicStorage);
+                }
+                buffers.clear();
+                GL_CALL(glFinish());
+                deletionQueue().drain();
+            });
+
+            gla::BufferHeap heap(gla::BufferType::Array, BLOCK_SIZE);
+            std::vector<gla::BufferSlice> slices(count);
+            double heaped = measure([&] {
+                for (int i = 0; i < count; i++) {
+                    slices[i] = heap.allocate(sizeOf(i));
+                    slices[i].setSubData(0, sizeOf(i), data.data());
+                }
+                for (gla::BufferSlice& slice : slices)
+                    heap.free(slice);
+                GL_CALL(glFinish());
+            });
+            std::printf("%8d %14.1f %16.1f %7.2fx\n", count, standalone / 1000.0, heaped / 1000.0, standalone / heaped);
+
+            // churn: free every other slice and allocate bigger ones, then report how fragmented the heap became
+            for (int i = 0; i < count; i++)
+                slices[i] = heap.allocate(sizeOf(i));
+            for (int i = 0; i < count; i += 2)
+                heap.free(slices[i]);
+            for (int i = 0; i < count; i += 2)
+                slices[i] = heap.allocate(sizeOf(i) + 4096);
+            gla::BufferHeapStats stats = heap.stats();
+            std::printf("%8s blocks %u, free regions %u, reserved %lld B, used %lld B, largest free %lld B, fragmentation %.3f\n", "", stats.blocks, stats.freeRegions,
+                static_cast<long long>(stats.reservedBytes), static_cast<long long>(stats.usedBytes), static_cast<long long>(stats.largestFreeRegion), stats.fragmentation());
+            for (gla::BufferSlice& slice : slices)
+                heap.free(slice);
+        }
+        std::printf("\n");
+    }
+
+    void run() override {
+        useContext();
+        benchVertexSetup();
+        benchUpdatePolicy();
+        benchBufferHeap();
+    }
+};
+
+int main(void)
+{
+    benchInterleave();
+
+    if (!gla::initGLFW())
+        return 1;
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+    {
+        BenchWindow window;
+        window.run();
+    }
+
+    gla::terminateGLFW();
+    return 0;
+}
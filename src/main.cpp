@@ -10,7 +10,9 @@
 #include <GLA/program.h>
 #include <GLA/shader.h>
 #include <GLA/buffer.h>
-#include <GLA/vertexArray.h>
+#include <GLA/indexBuffer.h>
+#include <GLA/vertexArrayObject.h>
+#include <GLA/staticVertexLayout.h>
 #include <GLA/debug.h>
 #include <GLA/windowContext.h>
 
@@ -18,6 +20,8 @@ struct Vertex {
     glm::vec2 pos;
 };
 
+constexpr auto vertexLayout = gla::staticVertexLayout<Vertex>(GLA_ATTRIBUTE(Vertex, pos, 0));
+
 class TestWindow : public gla::WindowContext {
 private:
     int _width, _height;
@@ -51,10 +55,17 @@ public:
             {{-1.0f,  1.0f}}
         };
 
-        gla::VertexArray vbo;
+        std::vector<uint32_t> indices = gla::weldVertices(positions);
+
+        gla::Buffer vbo(gla::BufferType::Array);
         vbo.setData(positions, gla::BufferUsage::StaticDraw);
-        vbo.bind(); 
-        vbo.setAttributes({{0, 2, gla::VertexAttribType::Float, gla::VertexAttribInterp::Float, false, offsetof(Vertex, pos)}}, sizeof(Vertex));
+
+        gla::IndexBuffer ibo;
+        ibo.setIndices(indices);
+
+        gla::VertexArrayObject vao;
+        vao.setVertexBuffer(vbo, vertexLayout);
+        vao.setElementBuffer(ibo.buffer());
 
         gla::Shader vertex(gla::ShaderType::Vertex, std::ifstream("../../res/shaders/basicTriangle/vertex.shader"));
         gla::Shader fragment(gla::ShaderType::Fragment, std::ifstream("../../res/shaders/basicTriangle/fragment.shader"));
@@ -66,6 +77,7 @@ public:
         program.link();
 
         program.bind();
+        vao.bind();
 
         auto start = std::chrono::system_clock::now();
 
@@ -85,7 +97,7 @@ public:
             else
                 program["uColor"] = glm::vec4(val, 1.0f, val, 1.0f);
 
-            GL_CALL(glDrawArrays(GL_TRIANGLES, 0, (int)positions.size()));
+            ibo.draw(gla::PrimitiveMode::Triangles);
 
             swapBuffers();
 